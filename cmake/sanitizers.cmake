@@ -1,10 +1,14 @@
-if (CMAKE_CXX_COMPILER_ID MATCHES "Clang") 
-    option(WITH_ASAN "Using clang address santisizer" OFF)
-    option(WITH_TSAN "Using clang thread santisizer" OFF)
-    option(WITH_MSAN "Using clang memory santisizer" OFF)
-    option(WITH_UBSAN "Using clang undefined-behaviour santisizer" OFF)
+if (CMAKE_CXX_COMPILER_ID MATCHES "Clang|GNU") 
+    option(WITH_ASAN "Using address santisizer" OFF)
+    option(WITH_TSAN "Using thread santisizer" OFF)
+    option(WITH_UBSAN "Using undefined-behaviour santisizer" OFF)
 
-    set (CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -O1 -g")
+    # gcc has no memory sanitizer
+    if (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        option(WITH_MSAN "Using clang memory santisizer" OFF)
+
+        set (CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -O1 -g")
+    endif()
 
     if (WITH_ASAN) 
         set (CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -fsanitize=address -fno-omit-frame-pointer")
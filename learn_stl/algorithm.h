@@ -300,13 +300,13 @@ constexpr void swap(T& a, T& b) {
 template <typename Iterator>
 inline void reverse(Iterator first, Iterator last) {
     while (first != last && first != --last) {
-        swap(*first++, *last);
+        ::learn::swap(*first++, *last);
     }
 }
 
 template <class ForwardItA, class ForwardItB>
 constexpr void iter_swap(ForwardItA a, ForwardItB b) {
-    swap(*a, *b);
+    ::learn::swap(*a, *b);
 }
 
 template <class Iterator>
@@ -320,7 +320,7 @@ Iterator rotate(Iterator first, Iterator new_first, Iterator last) {
     }
 
     for (Iterator next = new_first; next != last;) {
-        iter_swap(first++, next++);
+        ::learn::iter_swap(first++, next++);
         if (first == new_first) {
             new_first = next;
         }
@@ -329,7 +329,7 @@ Iterator rotate(Iterator first, Iterator new_first, Iterator last) {
     Iterator result = first;
 
     for (Iterator next = new_first; next != last;) {
-        iter_swap(first++, next++);
+        ::learn::iter_swap(first++, next++);
         if (first == new_first) {
             new_first = next;
         } else if (next == last) {
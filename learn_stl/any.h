@@ -1,117 +1,312 @@
 #pragma once
 
-#include <functional>
+#include <memory>
+#include <new>
 #include <type_traits>
 #include <typeinfo>
 
 #include "algorithm.h"
 #include "memory.h"
+#include "type_traits.h"
 #include "utility.h"
 
+#if defined(__cpp_rtti) || defined(__GXX_RTTI) || defined(_CPPRTTI)
+#define LEARN_STL_HAS_RTTI 1
+#endif
+
 namespace learn {
-class any {
+namespace detail {
+inline constexpr std::size_t any_buffer_size = 3 * sizeof(void*);
+inline constexpr std::size_t any_buffer_align = alignof(void*);
+
+// objects are only stored inline if moving them can't throw, otherwise a throwing move would
+// leave the any in a broken state half way through a move or swap
+template <typename Object>
+inline constexpr bool any_fits_inline = sizeof(Object) <= any_buffer_size &&
+                                        any_buffer_align % alignof(Object) == 0 &&
+                                        std::is_nothrow_move_constructible<Object>::value;
+
+// a compile-time type identity that doesn't need RTTI; every type gets its own static member,
+// and so its own unique address
+using type_id_t = const void*;
+
+template <typename Object>
+struct type_id_tag {
+    static constexpr char id = 0;
+};
+
+template <typename Object>
+constexpr type_id_t type_id() noexcept {
+    return &type_id_tag<Object>::id;
+}
+}  // namespace detail
+
+// Copyable is false for unique_any, which drops the copy operation so it can hold move-only
+// types; heap allocated objects come from Allocator, rebound to the stored type
+template <class Allocator, bool Copyable = true>
+class basic_any : private Allocator {
+    struct nonesuch;
+    using CopySource = std::conditional_t<Copyable, basic_any, nonesuch>;
+
   public:
-    any() = default;
+    using allocator_type = Allocator;
 
-    template <typename Object>
-    any(const Object& object) : container_(Container<std::decay_t<Object>>::make(object)) {}
+    basic_any() = default;
+    explicit basic_any(const allocator_type& alloc) noexcept : Allocator(alloc) {}
+
+    template <typename Object, typename = std::enable_if_t<
+                                   !std::is_same<std::decay_t<Object>, basic_any>::value &&
+                                   !std::is_same<std::decay_t<Object>, allocator_type>::value>>
+    basic_any(Object&& object) {
+        create<std::decay_t<Object>>(::learn::forward<Object>(object));
+    }
 
     template <typename Object>
-    any(Object&& object)
-        : container_(Container<std::decay_t<Object>>::make(forward<Object>(object))) {}
+    basic_any(std::allocator_arg_t, const allocator_type& alloc, Object&& object)
+        : Allocator(alloc) {
+        create<std::decay_t<Object>>(::learn::forward<Object>(object));
+    }
 
-    any(const any& other) : container_(other.container_->copy()) {}
-    any(any&& other) : container_(learn::move(other.container_)) { other.reset(); }
+    // when Copyable is false this isn't a copy constructor, and the implicit one is deleted
+    basic_any(const CopySource& other)
+        : Allocator(std::allocator_traits<Allocator>::select_on_container_copy_construction(
+              other.get_allocator())) {
+        if (other.has_value()) {
+            other.vtable_->copy(other, *this);
+            vtable_ = other.vtable_;
+        }
+    }
+
+    basic_any(basic_any&& other) noexcept : Allocator(other.get_allocator()) { move_from(other); }
 
-    any& operator=(const any& other) {
-        container_ = other.container_->copy();
+    ~basic_any() { reset(); }
+
+    basic_any& operator=(const CopySource& other) {
+        basic_any(other).swap(*this);
         return *this;
     }
 
-    any& operator=(any&& other) {
-        container_ = ::learn::move(other.container_);
-        other.reset();
+    basic_any& operator=(basic_any&& other) noexcept {
+        basic_any(::learn::move(other)).swap(*this);
         return *this;
     }
 
-    template <typename Object, typename... Args>
-    auto& emplace(Args&&... args) {
-        container_ = Container<Object>::make(forward<Args>(args)...);
-        return static_cast<Container<Object>&>(*container_).data;
+    template <typename Object,
+              typename = std::enable_if_t<!std::is_same<std::decay_t<Object>, basic_any>::value>>
+    basic_any& operator=(Object&& object) {
+        basic_any(std::allocator_arg, get_allocator(), ::learn::forward<Object>(object))
+            .swap(*this);
+        return *this;
     }
 
-    void reset() noexcept { container_.reset(); }
-    void swap(any& other) noexcept { ::learn::swap(container_, other.container_); }
+    template <typename Object, typename... Args>
+    std::decay_t<Object>& emplace(Args&&... args) {
+        using Value = std::decay_t<Object>;
 
-    bool has_value() const noexcept { return bool(container_); }
-    const std::type_info& type() const noexcept {
+        reset();
+        create<Value>(::learn::forward<Args>(args)...);
+
+        return *Manager<Value>::access(*this);
+    }
+
+    void reset() noexcept {
         if (has_value()) {
-            return container_->type();
+            vtable_->destroy(*this);
+            vtable_ = nullptr;
         }
+    }
 
-        return typeid(void);
+    // the allocators are swapped along with the objects, as heap allocated objects are moved by
+    // stealing their pointer
+    void swap(basic_any& other) noexcept {
+        if (this == &other) {
+            return;
+        }
+
+        basic_any tmp(::learn::move(other));
+        other.move_from(*this);
+        move_from(tmp);
     }
 
-    template <typename Object>
-    friend const Object* any_cast(const any* value);
+    bool has_value() const noexcept { return vtable_ != nullptr; }
 
-    template <typename Object>
-    friend Object* any_cast(any* value);
+    allocator_type get_allocator() const noexcept { return static_cast<const Allocator&>(*this); }
+
+    detail::type_id_t type_id() const noexcept {
+        return has_value() ? vtable_->type_id : detail::type_id<void>();
+    }
+
+#ifdef LEARN_STL_HAS_RTTI
+    const std::type_info& type() const noexcept {
+        return has_value() ? *vtable_->type : typeid(void);
+    }
+#endif
+
+    template <typename Object, class OtherAllocator, bool OtherCopyable>
+    friend const Object* any_cast(const basic_any<OtherAllocator, OtherCopyable>* value) noexcept;
+
+    template <typename Object, class OtherAllocator, bool OtherCopyable>
+    friend Object* any_cast(basic_any<OtherAllocator, OtherCopyable>* value) noexcept;
 
   private:
-    template <typename T>
-    struct ErasedDeleter : std::function<void(T*)> {
-        ErasedDeleter() : std::function<void(T*)>{[](T* p) { delete p; }} {}
+    union Storage {
+        void* ptr;
+        typename aligned_storage<detail::any_buffer_size, detail::any_buffer_align>::type buffer;
+    };
+
+    // a hand written vtable, one static instance per stored type; unlike a virtual base class
+    // it doesn't need the object to be heap allocated, or RTTI to recover the type
+    struct VTable {
+        detail::type_id_t type_id;
+        void (*copy)(const basic_any& self, basic_any& other);
+        void (*move)(basic_any& self, basic_any& other) noexcept;
+        void (*destroy)(basic_any& self) noexcept;
+#ifdef LEARN_STL_HAS_RTTI
+        const std::type_info* type;
+#endif
     };
 
-    template <typename T>
-    using ErasedPtr = unique_ptr<T, ErasedDeleter<T>>;
+    template <typename Object>
+    struct InlineManager {
+        template <typename... Args>
+        static void create(basic_any& self, Args&&... args) {
+            ::new (static_cast<void*>(&self.storage_.buffer))
+                Object(::learn::forward<Args>(args)...);
+        }
 
-    struct ContainerInterface {
-        using Ptr = ErasedPtr<ContainerInterface>;
+        static Object* access(const basic_any& self) noexcept {
+            const auto* buffer = &self.storage_.buffer;
+            return const_cast<Object*>(reinterpret_cast<const Object*>(buffer));
+        }
+
+        static void copy(const basic_any& self, basic_any& other) { create(other, *access(self)); }
 
-        virtual ~ContainerInterface() = default;
-        virtual const std::type_info& type() const = 0;
+        static void move(basic_any& self, basic_any& other) noexcept {
+            create(other, ::learn::move(*access(self)));
+            access(self)->~Object();
+        }
 
-        virtual Ptr copy() const = 0;
+        static void destroy(basic_any& self) noexcept { access(self)->~Object(); }
     };
 
-    template <typename ObjectT>
-    struct Container : ContainerInterface {
-        using Object = std::decay_t<ObjectT>;
+    template <typename Object>
+    struct HeapManager {
+        using Traits = typename std::allocator_traits<Allocator>::template rebind_traits<Object>;
+        using ObjectAllocator = typename Traits::allocator_type;
 
         template <typename... Args>
-        static Ptr make(Args&&... args) {
-            return Ptr(new Container(forward<Args>(args)...));
+        static void create(basic_any& self, Args&&... args) {
+            ObjectAllocator alloc(self.get_allocator());
+            Object* object = Traits::allocate(alloc, 1);
+
+            try {
+                Traits::construct(alloc, object, ::learn::forward<Args>(args)...);
+            } catch (...) {
+                Traits::deallocate(alloc, object, 1);
+                throw;
+            }
+
+            self.storage_.ptr = object;
         }
 
-        explicit Container(const Object& _data) : data(_data) {}
-        explicit Container(Object&& _data) : data(forward<Object>(_data)) {}
-        Object data;
+        static Object* access(const basic_any& self) noexcept {
+            return static_cast<Object*>(self.storage_.ptr);
+        }
 
-        const std::type_info& type() const final { return typeid(data); }
+        static void copy(const basic_any& self, basic_any& other) { create(other, *access(self)); }
 
-        Ptr copy() const final { return make(data); }
+        // moving a heap allocated object is just stealing the pointer
+        static void move(basic_any& self, basic_any& other) noexcept {
+            other.storage_.ptr = self.storage_.ptr;
+        }
+
+        static void destroy(basic_any& self) noexcept {
+            ObjectAllocator alloc(self.get_allocator());
+            Traits::destroy(alloc, access(self));
+            Traits::deallocate(alloc, access(self), 1);
+        }
     };
 
-    ContainerInterface::Ptr container_;
+    template <typename Object>
+    using Manager = std::conditional_t<detail::any_fits_inline<Object>, InlineManager<Object>,
+                                       HeapManager<Object>>;
+
+    // move-only objects get no copy function, so it's never instantiated
+    template <typename Object>
+    static constexpr auto copy_fn() {
+        if constexpr (Copyable) {
+            return &Manager<Object>::copy;
+        } else {
+            return static_cast<void (*)(const basic_any&, basic_any&)>(nullptr);
+        }
+    }
+
+    template <typename Object>
+    static constexpr VTable vtable_for = {
+        detail::type_id<Object>(),
+        copy_fn<Object>(),
+        &Manager<Object>::move,
+        &Manager<Object>::destroy,
+#ifdef LEARN_STL_HAS_RTTI
+        &typeid(Object),
+#endif
+    };
+
+    template <typename Object, typename... Args>
+    void create(Args&&... args) {
+        static_assert(!Copyable || std::is_copy_constructible<Object>::value,
+                      "any can only hold copyable types, use unique_any for move-only types");
+
+        Manager<Object>::create(*this, ::learn::forward<Args>(args)...);
+        vtable_ = &vtable_for<Object>;
+    }
+
+    // this must be empty, other is left empty and this takes its allocator
+    void move_from(basic_any& other) noexcept {
+        static_cast<Allocator&>(*this) = other.get_allocator();
+
+        if (other.has_value()) {
+            other.vtable_->move(other, *this);
+            vtable_ = other.vtable_;
+            other.vtable_ = nullptr;
+        }
+    }
+
+    const VTable* vtable_ = nullptr;
+    Storage storage_;
 };
 
-template <typename Object>
-const Object* any_cast(const any* value) {
-    auto container_ptr = dynamic_cast<const any::Container<Object>*>(value->container_.get());
+using any = basic_any<allocator<unsigned char>>;
+using unique_any = basic_any<allocator<unsigned char>, false>;
+
+template <class Allocator>
+using basic_unique_any = basic_any<Allocator, false>;
+
+// comparing the vtable pointer is the whole type check
+template <typename Object, class Allocator, bool Copyable>
+const Object* any_cast(const basic_any<Allocator, Copyable>* value) noexcept {
+    using Any = basic_any<Allocator, Copyable>;
 
-    return container_ptr ? addressof(container_ptr->data) : nullptr;
+    if (!value || value->vtable_ != &Any::template vtable_for<Object>) {
+        return nullptr;
+    }
+
+    return Any::template Manager<Object>::access(*value);
 }
 
-template <typename Object>
-Object* any_cast(any* value) {
-    auto container_ptr = dynamic_cast<any::Container<Object>*>(value->container_.get());
-    return container_ptr ? addressof(container_ptr->data) : nullptr;
+template <typename Object, class Allocator, bool Copyable>
+Object* any_cast(basic_any<Allocator, Copyable>* value) noexcept {
+    using Any = basic_any<Allocator, Copyable>;
+
+    if (!value || value->vtable_ != &Any::template vtable_for<Object>) {
+        return nullptr;
+    }
+
+    return Any::template Manager<Object>::access(*value);
 }
 
-template <typename Object>
-Object any_cast(const any& value) {
+template <typename Object, class Allocator, bool Copyable>
+Object any_cast(const basic_any<Allocator, Copyable>& value) {
     const auto value_ptr = any_cast<Object>(&value);
 
     if (!value_ptr) {
@@ -121,8 +316,8 @@ Object any_cast(const any& value) {
     return *value_ptr;
 }
 
-template <typename Object>
-Object any_cast(any& value) {
+template <typename Object, class Allocator, bool Copyable>
+Object any_cast(basic_any<Allocator, Copyable>& value) {
     const auto value_ptr = any_cast<Object>(&value);
 
     if (!value_ptr) {
@@ -132,17 +327,20 @@ Object any_cast(any& value) {
     return *value_ptr;
 }
 
-template <typename Object>
-Object any_cast(any&& value) {
+template <typename Object, class Allocator, bool Copyable>
+Object any_cast(basic_any<Allocator, Copyable>&& value) {
     const auto value_ptr = any_cast<Object>(&value);
 
     if (!value_ptr) {
         throw std::bad_cast();
     }
 
-    return move(*value_ptr);
+    return ::learn::move(*value_ptr);
 }
 
-void swap(any& lhs, any& rhs) { lhs.swap(rhs); }
+template <class Allocator, bool Copyable>
+void swap(basic_any<Allocator, Copyable>& lhs, basic_any<Allocator, Copyable>& rhs) noexcept {
+    lhs.swap(rhs);
+}
 
-}  // namespace learn
\ No newline at end of file
+}  // namespace learn
@@ -0,0 +1,445 @@
+#pragma once
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include <stdexcept>
+#include <type_traits>
+
+#include "array.h"
+#include "vector.h"
+
+#if defined(__GNUC__)
+#define LEARN_STL_VECTOR_EXTENSIONS 1
+#endif
+
+namespace learn {
+namespace detail {
+template <typename T>
+inline constexpr bool is_simd_element =
+    (std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+    std::is_same<T, float>::value || std::is_same<T, double>::value;
+
+// the width of the target's vector registers
+#if defined(__AVX512F__)
+inline constexpr std::size_t simd_register_bytes = 64;
+#elif defined(__AVX__)
+inline constexpr std::size_t simd_register_bytes = 32;
+#else
+inline constexpr std::size_t simd_register_bytes = 16;
+#endif
+
+// the lanes an array of N elements is processed in, or 0 for plain loops; arrays of 2, 4, 8 and
+// 16 elements are split into whole registers, and 3 is padded out to 4. A register never holds
+// more than the target's width, so an array of 8 doubles is one AVX-512 register or four SSE ones
+template <typename T, std::size_t N>
+constexpr std::size_t simd_lanes() {
+#if defined(LEARN_STL_VECTOR_EXTENSIONS)
+    if constexpr (is_simd_element<T> && (N == 2 || N == 3 || N == 4 || N == 8 || N == 16)) {
+        constexpr std::size_t padded = (N == 3) ? 4 : N;
+        constexpr std::size_t widest = simd_register_bytes / sizeof(T);
+
+        return padded < widest ? padded : widest;
+    }
+#endif
+    return 0;
+}
+
+#if defined(LEARN_STL_VECTOR_EXTENSIONS)
+template <typename T, std::size_t Lanes>
+struct simd_vector {
+    typedef T type __attribute__((vector_size(sizeof(T) * Lanes)));
+};
+
+// the register starting at element first; arrays are only aligned to T, so they're copied in and
+// out of registers with memcpy, which compiles to unaligned loads and stores. pad fills the lanes
+// past the end of the array
+template <std::size_t Lanes, typename T, std::size_t N>
+typename simd_vector<T, Lanes>::type simd_load(const array<T, N>& values, std::size_t first,
+                                               T pad) {
+    constexpr std::size_t tail = N % Lanes;
+    const std::size_t count = (tail != 0 && first + Lanes > N) ? tail : Lanes;
+
+    typename simd_vector<T, Lanes>::type result;
+    std::memcpy(&result, values.data() + first, sizeof(T) * count);
+    for (std::size_t i = count; i < Lanes; ++i) {
+        result[i] = pad;
+    }
+
+    return result;
+}
+
+template <std::size_t Lanes, typename T, std::size_t N>
+void simd_store(array<T, N>& values, std::size_t first,
+                const typename simd_vector<T, Lanes>::type& vector) {
+    constexpr std::size_t tail = N % Lanes;
+    const std::size_t count = (tail != 0 && first + Lanes > N) ? tail : Lanes;
+
+    std::memcpy(values.data() + first, &vector, sizeof(T) * count);
+}
+#endif
+
+// applies op lane by lane, to whole registers where simd_lanes allows; op is called with either
+// registers or single values. pad is what the spare lanes of a padded register hold, e.g. 1 so
+// that an integer division doesn't divide by zero
+template <typename T, std::size_t N, class Op>
+array<T, N> elementwise(const array<T, N>& lhs, const array<T, N>& rhs, Op op, T pad = T(0)) {
+    array<T, N> result;
+
+#if defined(LEARN_STL_VECTOR_EXTENSIONS)
+    constexpr std::size_t lanes = simd_lanes<T, N>();
+    if constexpr (lanes != 0) {
+        for (std::size_t first = 0; first < N; first += lanes) {
+            const auto lhs_lanes = simd_load<lanes>(lhs, first, pad);
+            const auto rhs_lanes = simd_load<lanes>(rhs, first, pad);
+            simd_store<lanes>(result, first, op(lhs_lanes, rhs_lanes));
+        }
+
+        return result;
+    }
+#endif
+
+    for (std::size_t i = 0; i < N; ++i) {
+        result[i] = op(lhs[i], rhs[i]);
+    }
+
+    return result;
+}
+
+// the unary form, op is called with a single register or value
+template <typename T, std::size_t N, class Op>
+array<T, N> elementwise(const array<T, N>& values, Op op) {
+    array<T, N> result;
+
+#if defined(LEARN_STL_VECTOR_EXTENSIONS)
+    constexpr std::size_t lanes = simd_lanes<T, N>();
+    if constexpr (lanes != 0) {
+        for (std::size_t first = 0; first < N; first += lanes) {
+            simd_store<lanes>(result, first, op(simd_load<lanes>(values, first, T(0))));
+        }
+
+        return result;
+    }
+#endif
+
+    for (std::size_t i = 0; i < N; ++i) {
+        result[i] = op(values[i]);
+    }
+
+    return result;
+}
+
+template <typename T, std::size_t N>
+array<T, N> broadcast(const T& value) {
+    array<T, N> result;
+    for (std::size_t i = 0; i < N; ++i) {
+        result[i] = value;
+    }
+
+    return result;
+}
+
+struct add_op {
+    template <typename V>
+    V operator()(const V& lhs, const V& rhs) const {
+        return lhs + rhs;
+    }
+};
+
+struct subtract_op {
+    template <typename V>
+    V operator()(const V& lhs, const V& rhs) const {
+        return lhs - rhs;
+    }
+};
+
+struct multiply_op {
+    template <typename V>
+    V operator()(const V& lhs, const V& rhs) const {
+        return lhs * rhs;
+    }
+};
+
+struct divide_op {
+    template <typename V>
+    V operator()(const V& lhs, const V& rhs) const {
+        return lhs / rhs;
+    }
+};
+
+// negates rather than subtracting from zero, which would give +0.0 for 0.0 and keep a NaN's sign
+struct negate_op {
+    template <typename V>
+    V operator()(const V& value) const {
+        return -value;
+    }
+};
+
+struct min_op {
+    template <typename V>
+    V operator()(const V& lhs, const V& rhs) const {
+        return rhs < lhs ? rhs : lhs;
+    }
+};
+
+struct max_op {
+    template <typename V>
+    V operator()(const V& lhs, const V& rhs) const {
+        return lhs < rhs ? rhs : lhs;
+    }
+};
+}  // namespace detail
+
+// element-wise arithmetic, the scalar forms apply the scalar to every element
+template <typename T, std::size_t N>
+array<T, N> operator+(const array<T, N>& lhs, const array<T, N>& rhs) {
+    return detail::elementwise(lhs, rhs, detail::add_op());
+}
+
+template <typename T, std::size_t N>
+array<T, N> operator-(const array<T, N>& lhs, const array<T, N>& rhs) {
+    return detail::elementwise(lhs, rhs, detail::subtract_op());
+}
+
+template <typename T, std::size_t N>
+array<T, N> operator*(const array<T, N>& lhs, const array<T, N>& rhs) {
+    return detail::elementwise(lhs, rhs, detail::multiply_op());
+}
+
+template <typename T, std::size_t N>
+array<T, N> operator/(const array<T, N>& lhs, const array<T, N>& rhs) {
+    return detail::elementwise(lhs, rhs, detail::divide_op(), T(1));
+}
+
+template <typename T, std::size_t N>
+array<T, N> operator-(const array<T, N>& values) {
+    return detail::elementwise(values, detail::negate_op());
+}
+
+template <typename T, std::size_t N>
+array<T, N> operator+(const array<T, N>& lhs, const typename array<T, N>::value_type& rhs) {
+    return lhs + detail::broadcast<T, N>(rhs);
+}
+
+template <typename T, std::size_t N>
+array<T, N> operator-(const array<T, N>& lhs, const typename array<T, N>::value_type& rhs) {
+    return lhs - detail::broadcast<T, N>(rhs);
+}
+
+template <typename T, std::size_t N>
+array<T, N> operator*(const array<T, N>& lhs, const typename array<T, N>::value_type& rhs) {
+    return lhs * detail::broadcast<T, N>(rhs);
+}
+
+template <typename T, std::size_t N>
+array<T, N> operator*(const typename array<T, N>::value_type& lhs, const array<T, N>& rhs) {
+    return detail::broadcast<T, N>(lhs) * rhs;
+}
+
+template <typename T, std::size_t N>
+array<T, N> operator/(const array<T, N>& lhs, const typename array<T, N>::value_type& rhs) {
+    return lhs / detail::broadcast<T, N>(rhs);
+}
+
+template <typename T, std::size_t N>
+array<T, N>& operator+=(array<T, N>& lhs, const array<T, N>& rhs) {
+    return lhs = lhs + rhs;
+}
+
+template <typename T, std::size_t N>
+array<T, N>& operator+=(array<T, N>& lhs, const typename array<T, N>::value_type& rhs) {
+    return lhs = lhs + rhs;
+}
+
+template <typename T, std::size_t N>
+array<T, N>& operator-=(array<T, N>& lhs, const array<T, N>& rhs) {
+    return lhs = lhs - rhs;
+}
+
+template <typename T, std::size_t N>
+array<T, N>& operator-=(array<T, N>& lhs, const typename array<T, N>::value_type& rhs) {
+    return lhs = lhs - rhs;
+}
+
+template <typename T, std::size_t N>
+array<T, N>& operator*=(array<T, N>& lhs, const array<T, N>& rhs) {
+    return lhs = lhs * rhs;
+}
+
+template <typename T, std::size_t N>
+array<T, N>& operator*=(array<T, N>& lhs, const typename array<T, N>::value_type& rhs) {
+    return lhs = lhs * rhs;
+}
+
+template <typename T, std::size_t N>
+array<T, N>& operator/=(array<T, N>& lhs, const array<T, N>& rhs) {
+    return lhs = lhs / rhs;
+}
+
+template <typename T, std::size_t N>
+array<T, N>& operator/=(array<T, N>& lhs, const typename array<T, N>::value_type& rhs) {
+    return lhs = lhs / rhs;
+}
+
+// the smaller and larger of each pair of elements
+template <typename T, std::size_t N>
+array<T, N> min(const array<T, N>& lhs, const array<T, N>& rhs) {
+    return detail::elementwise(lhs, rhs, detail::min_op());
+}
+
+template <typename T, std::size_t N>
+array<T, N> max(const array<T, N>& lhs, const array<T, N>& rhs) {
+    return detail::elementwise(lhs, rhs, detail::max_op());
+}
+
+template <typename T, std::size_t N>
+T dot(const array<T, N>& lhs, const array<T, N>& rhs) {
+    T result = T(0);
+
+#if defined(LEARN_STL_VECTOR_EXTENSIONS)
+    constexpr std::size_t lanes = detail::simd_lanes<T, N>();
+    if constexpr (lanes != 0) {
+        // padded lanes are zero, so add nothing to the sum
+        typename detail::simd_vector<T, lanes>::type sums = {};
+        for (std::size_t first = 0; first < N; first += lanes) {
+            sums += detail::simd_load<lanes>(lhs, first, T(0)) *
+                    detail::simd_load<lanes>(rhs, first, T(0));
+        }
+
+        for (std::size_t i = 0; i < lanes; ++i) {
+            result += sums[i];
+        }
+
+        return result;
+    }
+#endif
+
+    for (std::size_t i = 0; i < N; ++i) {
+        result += lhs[i] * rhs[i];
+    }
+
+    return result;
+}
+
+template <typename T>
+array<T, 3> cross(const array<T, 3>& lhs, const array<T, 3>& rhs) {
+    array<T, 3> result;
+    result[0] = lhs[1] * rhs[2] - lhs[2] * rhs[1];
+    result[1] = lhs[2] * rhs[0] - lhs[0] * rhs[2];
+    result[2] = lhs[0] * rhs[1] - lhs[1] * rhs[0];
+
+    return result;
+}
+
+template <typename T, std::size_t N>
+T squared_norm(const array<T, N>& values) {
+    return dot(values, values);
+}
+
+// the euclidean length, as a double for integer elements
+template <typename T, std::size_t N>
+auto norm(const array<T, N>& values) {
+    return std::sqrt(squared_norm(values));
+}
+
+// ------------------------------------------------------------------------------------
+// batched forms over every array in a vector; the element-wise ones treat the vector as one run of
+// N * size() values, so they fill whole registers even when N is 3
+
+namespace detail {
+template <typename T, std::size_t N, class Allocator>
+T* flat_data(vector<array<T, N>, Allocator>& values) {
+    static_assert(sizeof(array<T, N>) == N * sizeof(T), "arrays must be tightly packed");
+    return reinterpret_cast<T*>(values.data());
+}
+
+template <typename T, std::size_t N, class Allocator>
+const T* flat_data(const vector<array<T, N>, Allocator>& values) {
+    static_assert(sizeof(array<T, N>) == N * sizeof(T), "arrays must be tightly packed");
+    return reinterpret_cast<const T*>(values.data());
+}
+
+template <class Lhs, class Rhs>
+void check_batch_sizes(const Lhs& lhs, const Rhs& rhs) {
+    if (lhs.size() != rhs.size()) {
+        throw std::invalid_argument("batches must be the same size");
+    }
+}
+
+template <typename T, std::size_t N, class Allocator, class Op>
+void batch_apply(vector<array<T, N>, Allocator>& values,
+                 const vector<array<T, N>, Allocator>& others, Op op) {
+    check_batch_sizes(values, others);
+
+    T* out = flat_data(values);
+    const T* in = flat_data(others);
+    const std::size_t count = values.size() * N;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = op(out[i], in[i]);
+    }
+}
+}  // namespace detail
+
+// values[i] += others[i]
+template <typename T, std::size_t N, class Allocator>
+void batch_add(vector<array<T, N>, Allocator>& values,
+               const vector<array<T, N>, Allocator>& others) {
+    detail::batch_apply(values, others, detail::add_op());
+}
+
+// values[i] -= others[i]
+template <typename T, std::size_t N, class Allocator>
+void batch_subtract(vector<array<T, N>, Allocator>& values,
+                    const vector<array<T, N>, Allocator>& others) {
+    detail::batch_apply(values, others, detail::subtract_op());
+}
+
+// values[i] *= others[i], element-wise
+template <typename T, std::size_t N, class Allocator>
+void batch_multiply(vector<array<T, N>, Allocator>& values,
+                    const vector<array<T, N>, Allocator>& others) {
+    detail::batch_apply(values, others, detail::multiply_op());
+}
+
+// values[i] *= factor
+template <typename T, std::size_t N, class Allocator>
+void batch_scale(vector<array<T, N>, Allocator>& values,
+                 const typename array<T, N>::value_type& factor) {
+    T* out = detail::flat_data(values);
+    const std::size_t count = values.size() * N;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] *= factor;
+    }
+}
+
+// dot(lhs[i], rhs[i]) for every i
+template <typename T, std::size_t N, class Allocator>
+vector<T> batch_dot(const vector<array<T, N>, Allocator>& lhs,
+                    const vector<array<T, N>, Allocator>& rhs) {
+    detail::check_batch_sizes(lhs, rhs);
+
+    vector<T> result;
+    result.reserve(lhs.size());
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        result.emplace_back(dot(lhs[i], rhs[i]));
+    }
+
+    return result;
+}
+
+// norm(values[i]) for every i
+template <typename T, std::size_t N, class Allocator>
+auto batch_norm(const vector<array<T, N>, Allocator>& values) {
+    vector<decltype(norm(values[0]))> result;
+    result.reserve(values.size());
+    for (const auto& value : values) {
+        result.emplace_back(norm(value));
+    }
+
+    return result;
+}
+
+}  // namespace learn
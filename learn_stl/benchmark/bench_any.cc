@@ -0,0 +1,67 @@
+#include "learn_stl/any.h"
+
+#include <any>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+template <typename Any, typename Object>
+const Object* cast(const Any* value);
+
+template <>
+const int* cast<learn::any, int>(const learn::any* value) {
+    return learn::any_cast<int>(value);
+}
+
+template <>
+const int* cast<std::any, int>(const std::any* value) {
+    return std::any_cast<int>(value);
+}
+
+template <>
+const double* cast<learn::any, double>(const learn::any* value) {
+    return learn::any_cast<double>(value);
+}
+
+template <>
+const double* cast<std::any, double>(const std::any* value) {
+    return std::any_cast<double>(value);
+}
+
+template <typename Any>
+void BM_AnyCastHit(benchmark::State& state) {
+    Any value = 42;
+    benchmark::DoNotOptimize(&value);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cast<Any, int>(&value));
+    }
+}
+
+template <typename Any>
+void BM_AnyCastMiss(benchmark::State& state) {
+    Any value = 42;
+    benchmark::DoNotOptimize(&value);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cast<Any, double>(&value));
+    }
+}
+
+template <typename Any>
+void BM_AnyCopy(benchmark::State& state) {
+    Any value = 42;
+
+    for (auto _ : state) {
+        Any copy = value;
+        benchmark::DoNotOptimize(&copy);
+    }
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_AnyCastHit, learn::any);
+BENCHMARK_TEMPLATE(BM_AnyCastHit, std::any);
+BENCHMARK_TEMPLATE(BM_AnyCastMiss, learn::any);
+BENCHMARK_TEMPLATE(BM_AnyCastMiss, std::any);
+BENCHMARK_TEMPLATE(BM_AnyCopy, learn::any);
+BENCHMARK_TEMPLATE(BM_AnyCopy, std::any);
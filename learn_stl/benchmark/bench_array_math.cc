@@ -0,0 +1,91 @@
+#include "learn_stl/array_math.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+template <std::size_t N>
+learn::vector<learn::array<double, N>> make_points(std::size_t count) {
+    learn::vector<learn::array<double, N>> points;
+    points.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        learn::array<double, N> point;
+        for (std::size_t j = 0; j < N; ++j) {
+            point[j] = static_cast<double>(i + j);
+        }
+        points.emplace_back(point);
+    }
+
+    return points;
+}
+
+template <std::size_t N>
+void BM_ArrayDotLoop(benchmark::State& state) {
+    const auto points = make_points<N>(state.range(0));
+
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (const auto& point : points) {
+            for (std::size_t j = 0; j < N; ++j) {
+                sum += point[j] * point[j];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+template <std::size_t N>
+void BM_ArrayDot(benchmark::State& state) {
+    const auto points = make_points<N>(state.range(0));
+
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (const auto& point : points) {
+            sum += learn::dot(point, point);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+template <std::size_t N>
+void BM_ArrayAddLoop(benchmark::State& state) {
+    auto points = make_points<N>(state.range(0));
+    const auto offsets = make_points<N>(state.range(0));
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            for (std::size_t j = 0; j < N; ++j) {
+                points[i][j] += offsets[i][j];
+            }
+        }
+        benchmark::DoNotOptimize(points.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+template <std::size_t N>
+void BM_ArrayBatchAdd(benchmark::State& state) {
+    auto points = make_points<N>(state.range(0));
+    const auto offsets = make_points<N>(state.range(0));
+
+    for (auto _ : state) {
+        learn::batch_add(points, offsets);
+        benchmark::DoNotOptimize(points.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ArrayDotLoop, 3)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ArrayDot, 3)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ArrayDotLoop, 4)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ArrayDot, 4)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ArrayDotLoop, 8)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ArrayDot, 8)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ArrayAddLoop, 3)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ArrayBatchAdd, 3)->Arg(1 << 16);
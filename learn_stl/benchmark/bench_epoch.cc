@@ -0,0 +1,42 @@
+#include "learn_stl/epoch.h"
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
+#include <benchmark/benchmark.h>
+
+#include "learn_stl/vector.h"
+
+namespace {
+using Snapshot = learn::vector<int>;
+
+learn::epoch_domain domain;
+std::atomic<Snapshot*> epoch_snapshot{new Snapshot(16, 1)};
+
+std::shared_mutex snapshot_mutex;
+Snapshot locked_snapshot(16, 1);
+
+// readers only, the cost of entering and leaving the read side
+void BM_EpochRead(benchmark::State& state) {
+    for (auto _ : state) {
+        auto guard = domain.pin();
+        const Snapshot* values = epoch_snapshot.load(std::memory_order_acquire);
+        benchmark::DoNotOptimize(values->back());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_SharedMutexRead(benchmark::State& state) {
+    for (auto _ : state) {
+        std::shared_lock<std::shared_mutex> lock(snapshot_mutex);
+        benchmark::DoNotOptimize(locked_snapshot.back());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+}  // namespace
+
+BENCHMARK(BM_EpochRead)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_SharedMutexRead)->ThreadRange(1, 64)->UseRealTime();
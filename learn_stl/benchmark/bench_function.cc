@@ -0,0 +1,75 @@
+#include "learn_stl/functional.h"
+
+#include <functional>
+
+#include <benchmark/benchmark.h>
+
+#include "learn_stl/array.h"
+
+namespace {
+// fits every small buffer
+struct SmallCallable {
+    long offset;
+
+    long operator()(long value) const { return value + offset; }
+};
+
+// too large for std::function's and learn::function's buffers, but not for the inplace_function
+struct LargeCallable {
+    learn::array<long, 6> offsets;
+
+    long operator()(long value) const { return value + offsets[0]; }
+};
+
+using LearnFunction = learn::function<long(long)>;
+using InplaceFunction = learn::inplace_function<long(long), sizeof(LargeCallable)>;
+using StdFunction = std::function<long(long)>;
+
+template <typename Function, typename Callable>
+void BM_Construct(benchmark::State& state) {
+    const Callable callable{{1}};
+
+    for (auto _ : state) {
+        Function fn = callable;
+        benchmark::DoNotOptimize(&fn);
+    }
+}
+
+template <typename Function, typename Callable>
+void BM_Call(benchmark::State& state) {
+    Function fn = Callable{{1}};
+    long value = 0;
+
+    for (auto _ : state) {
+        value = fn(value);
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+// a function_ref is built per call, the usual way of passing it down to an algorithm
+void BM_CallFunctionRef(benchmark::State& state) {
+    const SmallCallable callable{1};
+    long value = 0;
+
+    for (auto _ : state) {
+        learn::function_ref<long(long)> fn = callable;
+        value = fn(value);
+        benchmark::DoNotOptimize(value);
+    }
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Construct, LearnFunction, SmallCallable);
+BENCHMARK_TEMPLATE(BM_Construct, InplaceFunction, SmallCallable);
+BENCHMARK_TEMPLATE(BM_Construct, StdFunction, SmallCallable);
+BENCHMARK_TEMPLATE(BM_Construct, LearnFunction, LargeCallable);
+BENCHMARK_TEMPLATE(BM_Construct, InplaceFunction, LargeCallable);
+BENCHMARK_TEMPLATE(BM_Construct, StdFunction, LargeCallable);
+
+BENCHMARK_TEMPLATE(BM_Call, LearnFunction, SmallCallable);
+BENCHMARK_TEMPLATE(BM_Call, InplaceFunction, SmallCallable);
+BENCHMARK_TEMPLATE(BM_Call, StdFunction, SmallCallable);
+BENCHMARK_TEMPLATE(BM_Call, LearnFunction, LargeCallable);
+BENCHMARK_TEMPLATE(BM_Call, InplaceFunction, LargeCallable);
+BENCHMARK_TEMPLATE(BM_Call, StdFunction, LargeCallable);
+BENCHMARK(BM_CallFunctionRef);
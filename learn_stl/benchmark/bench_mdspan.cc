@@ -0,0 +1,79 @@
+#include "learn_stl/mdspan.h"
+
+#include <benchmark/benchmark.h>
+
+#include "learn_stl/vector.h"
+
+namespace {
+using Extents = learn::dextents<2>;
+
+learn::vector<double> make_storage(std::size_t count) { return learn::vector<double>(count, 1.0); }
+
+// sums each column, the worst case for row-major storage
+template <class Layout>
+void BM_ColumnSums(benchmark::State& state) {
+    const std::size_t n = state.range(0);
+    const Extents extents(n, n);
+    const typename Layout::template mapping<Extents> mapping(extents);
+
+    auto storage = make_storage(mapping.required_span_size());
+    const learn::mdspan<double, Extents, Layout> matrix(storage.data(), mapping);
+
+    for (auto _ : state) {
+        double total = 0.0;
+        for (std::size_t j = 0; j < n; ++j) {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += matrix(i, j);
+            }
+            total += sum;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * n * n);
+}
+
+void BM_TransposeNaive(benchmark::State& state) {
+    const std::size_t n = state.range(0);
+    auto source_storage = make_storage(n * n);
+    auto target_storage = make_storage(n * n);
+
+    const learn::mdspan<double, Extents> source(source_storage.data(), n, n);
+    const learn::mdspan<double, Extents> target(target_storage.data(), n, n);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                target(j, i) = source(i, j);
+            }
+        }
+        benchmark::DoNotOptimize(target.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * n * n);
+}
+
+void BM_TransposeTiled(benchmark::State& state) {
+    const std::size_t n = state.range(0);
+    auto source_storage = make_storage(n * n);
+    auto target_storage = make_storage(n * n);
+
+    const learn::mdspan<double, Extents> source(source_storage.data(), n, n);
+    const learn::mdspan<double, Extents> target(target_storage.data(), n, n);
+
+    for (auto _ : state) {
+        learn::for_each_index_tiled<16, 16>(
+            source.extents(), [&](std::size_t i, std::size_t j) { target(j, i) = source(i, j); });
+        benchmark::DoNotOptimize(target.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * n * n);
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ColumnSums, learn::layout_right)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_ColumnSums, learn::layout_left)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_ColumnSums, learn::layout_tiled<16, 16>)->Arg(2048);
+BENCHMARK(BM_TransposeNaive)->Arg(2048);
+BENCHMARK(BM_TransposeTiled)->Arg(2048);
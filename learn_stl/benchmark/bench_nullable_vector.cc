@@ -0,0 +1,74 @@
+#include "learn_stl/nullable_vector.h"
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "learn_stl/optional.h"
+
+namespace {
+// Arg(1) is the percentage of nulls
+bool is_null(std::size_t index, int null_percent) {
+    return static_cast<int>((index * 37) % 100) < null_percent;
+}
+
+void BM_OptionalVectorSum(benchmark::State& state) {
+    std::vector<learn::optional<double>> column;
+    for (std::size_t i = 0; i < static_cast<std::size_t>(state.range(0)); ++i) {
+        column.emplace_back();
+        if (!is_null(i, state.range(1))) {
+            column.back() = static_cast<double>(i);
+        }
+    }
+
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (const auto& value : column) {
+            if (value) {
+                sum += *value;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * column.size());
+}
+
+void BM_NullableVectorSum(benchmark::State& state) {
+    learn::nullable_vector<double> column;
+    for (std::size_t i = 0; i < static_cast<std::size_t>(state.range(0)); ++i) {
+        if (is_null(i, state.range(1))) {
+            column.push_null();
+        } else {
+            column.push_back(static_cast<double>(i));
+        }
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(learn::sum(column));
+    }
+
+    state.SetItemsProcessed(state.iterations() * column.size());
+}
+
+void BM_NullableVectorCount(benchmark::State& state) {
+    learn::nullable_vector<double> column;
+    for (std::size_t i = 0; i < static_cast<std::size_t>(state.range(0)); ++i) {
+        if (is_null(i, state.range(1))) {
+            column.push_null();
+        } else {
+            column.push_back(static_cast<double>(i));
+        }
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(learn::count(column));
+    }
+
+    state.SetItemsProcessed(state.iterations() * column.size());
+}
+}  // namespace
+
+BENCHMARK(BM_OptionalVectorSum)->ArgsProduct({{1 << 16}, {0, 10, 50}});
+BENCHMARK(BM_NullableVectorSum)->ArgsProduct({{1 << 16}, {0, 10, 50}});
+BENCHMARK(BM_NullableVectorCount)->ArgsProduct({{1 << 16}, {0, 10, 50}});
@@ -0,0 +1,34 @@
+#include "learn_stl/optional.h"
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+using FlagDouble = learn::optional<double>;
+using CompactDouble = learn::optional<double, learn::nan_sentinel<double>>;
+
+// a sparse column, every third value is missing
+template <typename Optional>
+void BM_OptionalSum(benchmark::State& state) {
+    std::vector<Optional> values(state.range(0));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (i % 3 != 0) {
+            values[i] = static_cast<double>(i);
+        }
+    }
+
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (const auto& value : values) {
+            sum += value.value_or(0.0);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetBytesProcessed(state.iterations() * values.size() * sizeof(Optional));
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_OptionalSum, FlagDouble)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_OptionalSum, CompactDouble)->Arg(1 << 10)->Arg(1 << 20);
@@ -0,0 +1,107 @@
+#include "learn_stl/poly_collection.h"
+
+#include <benchmark/benchmark.h>
+
+#include "learn_stl/any.h"
+#include "learn_stl/memory.h"
+#include "learn_stl/vector.h"
+
+namespace {
+struct Shape {
+    virtual ~Shape() = default;
+    virtual double area() const = 0;
+};
+
+struct Circle final : Shape {
+    explicit Circle(double r) : radius(r) {}
+    double area() const override { return 3 * radius * radius; }
+    double radius;
+};
+
+struct Square final : Shape {
+    explicit Square(double s) : side(s) {}
+    double area() const override { return side * side; }
+    double side;
+};
+
+struct Triangle final : Shape {
+    Triangle(double b, double h) : base(b), height(h) {}
+    double area() const override { return base * height / 2; }
+    double base;
+    double height;
+};
+
+// the element types are interleaved, so neither the branch predictor nor the prefetcher can
+// guess what comes next
+template <typename Insert>
+void fill(std::size_t count, Insert insert) {
+    for (std::size_t i = 0; i < count; ++i) {
+        switch ((i * 7) % 3) {
+            case 0:
+                insert(Circle(i));
+                break;
+            case 1:
+                insert(Square(i));
+                break;
+            default:
+                insert(Triangle(i, 2));
+                break;
+        }
+    }
+}
+
+void BM_VectorOfAny(benchmark::State& state) {
+    learn::vector<learn::any> shapes;
+    fill(state.range(0), [&](auto shape) { shapes.emplace_back(shape); });
+
+    for (auto _ : state) {
+        double total = 0;
+        for (auto& shape : shapes) {
+            if (const auto* circle = learn::any_cast<Circle>(&shape)) {
+                total += circle->area();
+            } else if (const auto* square = learn::any_cast<Square>(&shape)) {
+                total += square->area();
+            } else if (const auto* triangle = learn::any_cast<Triangle>(&shape)) {
+                total += triangle->area();
+            }
+        }
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_VectorOfPointers(benchmark::State& state) {
+    learn::vector<learn::unique_ptr<Shape>> shapes;
+    fill(state.range(0), [&](auto shape) {
+        shapes.emplace_back(new decltype(shape)(shape));
+    });
+
+    for (auto _ : state) {
+        double total = 0;
+        for (const auto& shape : shapes) {
+            total += shape->area();
+        }
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_PolyCollection(benchmark::State& state) {
+    learn::poly_collection<Circle, Square, Triangle> shapes;
+    fill(state.range(0), [&](auto shape) { shapes.insert(shape); });
+
+    for (auto _ : state) {
+        double total = 0;
+        shapes.for_each([&total](const auto& shape) { total += shape.area(); });
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_VectorOfAny)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_VectorOfPointers)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PolyCollection)->Range(1 << 10, 1 << 20);
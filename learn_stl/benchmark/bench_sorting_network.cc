@@ -0,0 +1,69 @@
+#include "learn_stl/sorting_network.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+constexpr std::size_t num_arrays = 1024;
+
+template <std::size_t N>
+std::vector<learn::array<int, N>> make_arrays() {
+    std::mt19937 engine(7);
+    std::uniform_int_distribution<int> distribution(0, 1000);
+
+    std::vector<learn::array<int, N>> arrays(num_arrays);
+    for (auto& values : arrays) {
+        for (auto& value : values) {
+            value = distribution(engine);
+        }
+    }
+
+    return arrays;
+}
+
+template <std::size_t N>
+void BM_StdSort(benchmark::State& state) {
+    const auto input = make_arrays<N>();
+    auto arrays = input;
+
+    for (auto _ : state) {
+        arrays = input;
+        for (auto& values : arrays) {
+            std::sort(values.begin(), values.end());
+        }
+        benchmark::DoNotOptimize(arrays.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_arrays);
+}
+
+template <std::size_t N>
+void BM_SortingNetwork(benchmark::State& state) {
+    const auto input = make_arrays<N>();
+    auto arrays = input;
+
+    for (auto _ : state) {
+        arrays = input;
+        for (auto& values : arrays) {
+            learn::sort(values);
+        }
+        benchmark::DoNotOptimize(arrays.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_arrays);
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_StdSort, 4);
+BENCHMARK_TEMPLATE(BM_SortingNetwork, 4);
+BENCHMARK_TEMPLATE(BM_StdSort, 8);
+BENCHMARK_TEMPLATE(BM_SortingNetwork, 8);
+BENCHMARK_TEMPLATE(BM_StdSort, 16);
+BENCHMARK_TEMPLATE(BM_SortingNetwork, 16);
+BENCHMARK_TEMPLATE(BM_StdSort, 24);
+BENCHMARK_TEMPLATE(BM_SortingNetwork, 24);
+BENCHMARK_TEMPLATE(BM_StdSort, 32);
+BENCHMARK_TEMPLATE(BM_SortingNetwork, 32);
@@ -0,0 +1,88 @@
+#include "learn_stl/thread_cache.h"
+
+#include <new>
+
+#include <benchmark/benchmark.h>
+
+#include "learn_stl/vector.h"
+
+namespace {
+// a stateless allocator that always goes through the thread caching heap, independent of
+// whether learn::allocator was compiled with LEARN_STL_THREAD_CACHE
+template <class T>
+struct heap_allocator {
+    using value_type = T;
+
+    heap_allocator() noexcept = default;
+
+    template <class U>
+    heap_allocator(const heap_allocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(learn::thread_caching_heap::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        learn::thread_caching_heap::deallocate(p, n * sizeof(T));
+    }
+};
+
+template <class T>
+struct new_allocator {
+    using value_type = T;
+
+    new_allocator() noexcept = default;
+
+    template <class U>
+    new_allocator(const new_allocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(::operator new(n * sizeof(T))); }
+    void deallocate(T* p, std::size_t n) { ::operator delete(p, n * sizeof(T)); }
+};
+
+// many short lived small vectors, the churn the thread cache is meant to absorb
+template <template <class> class Allocator>
+void BM_SmallVectorChurn(benchmark::State& state) {
+    using Vector = learn::vector<int, Allocator<int>>;
+
+    for (auto _ : state) {
+        for (int i = 0; i < 64; ++i) {
+            Vector vector;
+            for (int j = 0; j < (i % 16) + 1; ++j) {
+                vector.emplace_back(j);
+            }
+            benchmark::DoNotOptimize(vector.data());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+
+template <template <class> class Allocator>
+void BM_AllocateFree(benchmark::State& state) {
+    Allocator<char> allocator;
+    const auto num_bytes = std::size_t(state.range(0));
+
+    for (auto _ : state) {
+        char* ptr = allocator.allocate(num_bytes);
+        benchmark::DoNotOptimize(ptr);
+        allocator.deallocate(ptr, num_bytes);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_SmallVectorChurn, new_allocator)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SmallVectorChurn, heap_allocator)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_AllocateFree, new_allocator)
+    ->Arg(32)
+    ->Arg(1024)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_AllocateFree, heap_allocator)
+    ->Arg(32)
+    ->Arg(1024)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
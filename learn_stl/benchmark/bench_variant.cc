@@ -0,0 +1,200 @@
+#include "learn_stl/variant.h"
+
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "learn_stl/vector.h"
+
+namespace {
+template <int I>
+struct Alternative {
+    int value = I;
+};
+
+template <template <typename...> class Variant, std::size_t... I>
+Variant<Alternative<I>...> make_variant(std::index_sequence<I...>);
+
+template <template <typename...> class Variant, std::size_t N>
+using variant_of = decltype(make_variant<Variant>(std::make_index_sequence<N>{}));
+
+template <class Variant, std::size_t... I>
+Variant make_alternative(std::size_t index, std::index_sequence<I...>) {
+    Variant value;
+    ((index == I ? (value = Alternative<I>{}, 0) : 0), ...);
+    return value;
+}
+
+// the alternatives are in a pseudo-random order, so the dispatch can't be predicted
+template <class Variant, std::size_t N>
+std::vector<Variant> make_values() {
+    std::vector<Variant> values;
+    for (std::size_t i = 0; i < 4096; ++i) {
+        const auto index = (i * 7919) % N;
+        values.emplace_back(make_alternative<Variant>(index, std::make_index_sequence<N>{}));
+    }
+    return values;
+}
+
+const auto sum = [](const auto& alternative) { return alternative.value; };
+const auto product = [](const auto& lhs, const auto& rhs) { return lhs.value * rhs.value; };
+
+template <std::size_t N>
+void BM_LearnVisit(benchmark::State& state) {
+    const auto values = make_values<variant_of<learn::variant, N>, N>();
+
+    for (auto _ : state) {
+        long total = 0;
+        for (const auto& value : values) {
+            total += learn::visit(sum, value);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+template <std::size_t N>
+void BM_StdVisit(benchmark::State& state) {
+    const auto values = make_values<variant_of<std::variant, N>, N>();
+
+    for (auto _ : state) {
+        long total = 0;
+        for (const auto& value : values) {
+            total += std::visit(sum, value);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// two variants, so the table has N * N entries
+template <std::size_t N>
+void BM_LearnVisitPair(benchmark::State& state) {
+    const auto values = make_values<variant_of<learn::variant, N>, N>();
+
+    for (auto _ : state) {
+        long total = 0;
+        for (std::size_t i = 1; i < values.size(); ++i) {
+            total += learn::visit(product, values[i - 1], values[i]);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// copying a vector of variants goes through the copy table for every element
+template <std::size_t N>
+void BM_LearnCopy(benchmark::State& state) {
+    const auto values = make_values<variant_of<learn::variant, N>, N>();
+
+    for (auto _ : state) {
+        auto copy = values;
+        benchmark::DoNotOptimize(copy.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// an interpreter style loop, a visitor whose body differs per alternative
+struct Accumulate {
+    long total = 0;
+
+    template <int I>
+    void operator()(const Alternative<I>& alternative) {
+        total = total * (I + 1) + alternative.value;
+    }
+};
+
+template <std::size_t N>
+void BM_VisitEach(benchmark::State& state) {
+    const auto values = make_values<variant_of<learn::variant, N>, N>();
+
+    for (auto _ : state) {
+        Accumulate accumulate;
+        for (const auto& value : values) {
+            learn::visit(accumulate, value);
+        }
+        benchmark::DoNotOptimize(accumulate.total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+template <std::size_t N>
+void BM_VisitBatched(benchmark::State& state) {
+    const auto values = make_values<variant_of<learn::variant, N>, N>();
+
+    for (auto _ : state) {
+        Accumulate accumulate;
+        learn::visit_batched(values, accumulate);
+        benchmark::DoNotOptimize(accumulate.total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// after the first iteration the values are already grouped, which is the steady state of a
+// loop that visits the same range repeatedly
+template <std::size_t N>
+void BM_VisitBatchedUnstable(benchmark::State& state) {
+    auto values = make_values<variant_of<learn::variant, N>, N>();
+
+    for (auto _ : state) {
+        Accumulate accumulate;
+        learn::visit_batched_unstable(values, accumulate);
+        benchmark::DoNotOptimize(accumulate.total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// the same layout as a double, but copying it isn't trivial, so neither is the variant
+struct CopyCounted {
+    CopyCounted() = default;
+    CopyCounted(const CopyCounted& other) : value(other.value) {}
+    double value = 0;
+};
+
+using TrivialVariant = learn::variant<int, float, double>;
+using NonTrivialVariant = learn::variant<int, float, CopyCounted>;
+
+// growing without a reserve, each reallocation either memmoves or moves element by element
+template <class Variant>
+void BM_Reallocate(benchmark::State& state) {
+    for (auto _ : state) {
+        learn::vector<Variant> values;
+        for (long i = 0; i < state.range(0); ++i) {
+            values.emplace_back(int(i));
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_LearnVisit, 2);
+BENCHMARK_TEMPLATE(BM_LearnVisit, 8);
+BENCHMARK_TEMPLATE(BM_LearnVisit, 32);
+BENCHMARK_TEMPLATE(BM_StdVisit, 2);
+BENCHMARK_TEMPLATE(BM_StdVisit, 8);
+BENCHMARK_TEMPLATE(BM_StdVisit, 32);
+BENCHMARK_TEMPLATE(BM_LearnVisitPair, 2);
+BENCHMARK_TEMPLATE(BM_LearnVisitPair, 8);
+BENCHMARK_TEMPLATE(BM_LearnVisitPair, 16);
+BENCHMARK_TEMPLATE(BM_LearnCopy, 2);
+BENCHMARK_TEMPLATE(BM_LearnCopy, 8);
+BENCHMARK_TEMPLATE(BM_LearnCopy, 32);
+BENCHMARK_TEMPLATE(BM_VisitEach, 8);
+BENCHMARK_TEMPLATE(BM_VisitEach, 32);
+BENCHMARK_TEMPLATE(BM_VisitBatched, 8);
+BENCHMARK_TEMPLATE(BM_VisitBatched, 32);
+BENCHMARK_TEMPLATE(BM_VisitBatchedUnstable, 8);
+BENCHMARK_TEMPLATE(BM_VisitBatchedUnstable, 32);
+BENCHMARK_TEMPLATE(BM_Reallocate, TrivialVariant)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_Reallocate, NonTrivialVariant)->Range(1 << 10, 1 << 18);
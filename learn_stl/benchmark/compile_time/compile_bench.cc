@@ -0,0 +1,82 @@
+// times compiling instantiate.cc for a growing number of types, reporting the compiler's wall
+// time and peak memory; usage: compile_bench <compiler> <instantiate.cc> <include dir> [N...]
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+struct Measurement {
+    bool succeeded;
+    double seconds;
+    long max_rss_kb;
+};
+
+Measurement compile(const std::vector<std::string>& command) {
+    std::vector<char*> argv;
+    for (const auto& arg : command) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    const pid_t pid = fork();
+    if (pid == 0) {
+        execvp(argv[0], argv.data());
+        std::perror("execvp");
+        std::_Exit(127);
+    }
+
+    // wait4 reports the child's own peak memory, rather than the peak of every child so far
+    int status = 0;
+    rusage usage{};
+    if (pid < 0 || wait4(pid, &status, 0, &usage) < 0) {
+        return {false, 0.0, 0};
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const bool succeeded = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+
+    return {succeeded, elapsed.count(), usage.ru_maxrss};
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::fprintf(stderr, "usage: %s <compiler> <instantiate.cc> <include dir> [N...]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    std::vector<std::string> sizes(argv + 4, argv + argc);
+    if (sizes.empty()) {
+        sizes = {"16", "128", "1024"};
+    }
+
+    std::printf("%8s %12s %14s\n", "N", "time (s)", "max RSS (MB)");
+
+    int result = 0;
+    for (const auto& size : sizes) {
+        const Measurement measurement = compile({argv[1], "-std=c++17", "-fsyntax-only",
+                                                 std::string("-I") + argv[3], "-DLEARN_N=" + size,
+                                                 argv[2]});
+
+        if (!measurement.succeeded) {
+            std::printf("%8s %12s %14s\n", size.c_str(), "failed", "-");
+            result = 1;
+            continue;
+        }
+
+        std::printf("%8s %12.2f %14.1f\n", size.c_str(), measurement.seconds,
+                    measurement.max_rss_kb / 1024.0);
+    }
+
+    return result;
+}
@@ -0,0 +1,37 @@
+// compiled, not run, by compile_bench with LEARN_N set to the number of types; instantiates a
+// tuple and a variant of LEARN_N distinct types and looks up every element of each
+#include "learn_stl/tuple.h"
+#include "learn_stl/utility.h"
+#include "learn_stl/variant.h"
+
+#ifndef LEARN_N
+#define LEARN_N 16
+#endif
+
+namespace {
+template <std::size_t I>
+struct tag {
+    int value = static_cast<int>(I);
+};
+
+template <typename Sequence>
+struct instantiate;
+
+template <std::size_t... Indices>
+struct instantiate<learn::index_sequence<Indices...>> {
+    using tuple = learn::tuple<tag<Indices>...>;
+    using variant = learn::variant<tag<Indices>...>;
+
+    static int run() {
+        const tuple values(tag<Indices>{}...);
+        const int tuple_sum = (learn::get<Indices>(values).value + ...);
+
+        const variant alternative = tag<sizeof...(Indices) - 1>{};
+        const int held = (learn::holds_alternative<tag<Indices>>(alternative) + ...);
+
+        return tuple_sum + held;
+    }
+};
+}  // namespace
+
+int main() { return instantiate<learn::make_index_sequence<LEARN_N>::type>::run() > 0 ? 0 : 1; }
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include "memory.h"
+#include "utility.h"
+#include "vector.h"
+
+namespace learn {
+
+// epoch based reclamation; readers pin the domain's epoch while they hold pointers to shared
+// objects, and retired objects are only deleted once every reader pinned when they were
+// retired has unpinned
+class epoch_domain {
+    struct record;
+
+  public:
+    class guard;
+
+    // retired objects a record collects before it tries to advance the epoch and reclaim them
+    static constexpr std::size_t reclaim_batch_size = 64;
+
+    epoch_domain() noexcept : id_(next_id().fetch_add(1, std::memory_order_relaxed)) {}
+    epoch_domain(const epoch_domain&) = delete;
+    epoch_domain& operator=(const epoch_domain&) = delete;
+
+    // every guard must have been destroyed, anything still retired is deleted
+    ~epoch_domain() {
+        record* rec = records_.load(std::memory_order_acquire);
+        while (rec) {
+            record* next = rec->next;
+            for (auto& retired : rec->retired) {
+                retired.reclaim(retired.ptr);
+            }
+            delete rec;
+            rec = next;
+        }
+    }
+
+    guard pin();
+
+    std::uint64_t epoch() const noexcept { return epoch_.load(std::memory_order_acquire); }
+
+    // process-wide domain for callers that don't need their own
+    static epoch_domain& global() {
+        static epoch_domain domain;
+        return domain;
+    }
+
+  private:
+    struct retired_object {
+        void* ptr;
+        void (*reclaim)(void*);
+        std::uint64_t epoch;
+    };
+
+    // a participant slot, claimed by one guard at a time; the state is (epoch << 1) | 1 while
+    // pinned and 0 otherwise
+    struct record {
+        std::atomic<std::uint64_t> state{0};
+        std::atomic<bool> in_use{true};
+        record* next = nullptr;
+        vector<retired_object> retired;
+    };
+
+    struct thread_hint {
+        std::uint64_t domain_id = 0;
+        record* rec = nullptr;
+    };
+
+    // ids are never reused, so a hint left behind by a destroyed domain is never followed
+    std::uint64_t id_;
+    std::atomic<std::uint64_t> epoch_{1};
+    std::atomic<record*> records_{nullptr};
+
+    static std::atomic<std::uint64_t>& next_id() {
+        static std::atomic<std::uint64_t> id{1};
+        return id;
+    }
+
+    static thread_hint& hint() {
+        thread_local thread_hint local;
+        return local;
+    }
+
+    static bool try_claim(record* rec) {
+        bool expected = false;
+        return !rec->in_use.load(std::memory_order_relaxed) &&
+               rec->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire);
+    }
+
+    // reuses the record this thread had last, so retire lists stay effectively per thread
+    record* acquire_record() {
+        auto& local = hint();
+        if (local.domain_id == id_ && try_claim(local.rec)) {
+            return local.rec;
+        }
+
+        record* rec = records_.load(std::memory_order_acquire);
+        for (; rec; rec = rec->next) {
+            if (try_claim(rec)) {
+                break;
+            }
+        }
+
+        if (!rec) {
+            rec = new record;
+            rec->next = records_.load(std::memory_order_relaxed);
+            while (!records_.compare_exchange_weak(rec->next, rec, std::memory_order_release,
+                                                   std::memory_order_relaxed)) {
+            }
+        }
+
+        local.domain_id = id_;
+        local.rec = rec;
+        return rec;
+    }
+
+    void release_record(record* rec) { rec->in_use.store(false, std::memory_order_release); }
+
+    // the epoch can only move on once every pinned record has observed the current one
+    void try_advance() {
+        auto epoch = epoch_.load(std::memory_order_seq_cst);
+
+        for (record* rec = records_.load(std::memory_order_acquire); rec; rec = rec->next) {
+            const auto state = rec->state.load(std::memory_order_seq_cst);
+            if ((state & 1) && (state >> 1) != epoch) {
+                return;
+            }
+        }
+
+        epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+    }
+
+    // objects retired at epoch e may still be read by guards pinned at e - 1 or e, both of
+    // which must have unpinned by the time the epoch reaches e + 2
+    void reclaim(record* rec) {
+        try_advance();
+
+        const auto epoch = epoch_.load(std::memory_order_acquire);
+        auto& retired = rec->retired;
+        auto last = retired.begin();
+
+        while (last != retired.end() && last->epoch + 2 <= epoch) {
+            last->reclaim(last->ptr);
+            ++last;
+        }
+
+        retired.erase(retired.begin(), last);
+    }
+};
+
+class epoch_domain::guard {
+  public:
+    guard(const guard&) = delete;
+    guard& operator=(const guard&) = delete;
+
+    guard(guard&& other) noexcept : domain_(other.domain_), record_(other.record_) {
+        other.record_ = nullptr;
+    }
+
+    ~guard() {
+        if (record_) {
+            record_->state.store(0, std::memory_order_release);
+            domain_->release_record(record_);
+        }
+    }
+
+    // only the deleter's type is kept, it's default constructed at reclaim time; a stateful
+    // deleter would need storing alongside every retired object
+    template <typename Object, class Deleter = default_delete<Object>>
+    void retire(Object* ptr) {
+        static_assert(std::is_empty<Deleter>::value && std::is_default_constructible_v<Deleter>,
+                      "retired objects can only use stateless deleters");
+
+        const auto reclaim = [](void* p) { Deleter()(static_cast<Object*>(p)); };
+        const auto epoch = domain_->epoch_.load(std::memory_order_acquire);
+        record_->retired.emplace_back(retired_object{ptr, reclaim, epoch});
+
+        if (record_->retired.size() >= reclaim_batch_size) {
+            domain_->reclaim(record_);
+        }
+    }
+
+    template <typename Object, class Deleter>
+    void retire(unique_ptr<Object, Deleter>&& ptr) {
+        retire<Object, Deleter>(ptr.release());
+    }
+
+    // the array's deleter, e.g. default_delete<T[]>, is kept, so the elements are deleted with
+    // delete[]
+    template <typename Object, class Deleter>
+    void retire(unique_ptr<Object[], Deleter>&& ptr) {
+        retire<Object, Deleter>(ptr.release());
+    }
+
+    // deletes whatever this guard's record has retired that is no longer reachable
+    void reclaim() { domain_->reclaim(record_); }
+
+  private:
+    friend class epoch_domain;
+
+    epoch_domain* domain_;
+    record* record_;
+
+    guard(epoch_domain* domain, record* rec) : domain_(domain), record_(rec) {
+        const auto epoch = domain_->epoch_.load(std::memory_order_acquire);
+        // a seq_cst read-modify-write, so the pin is visible before any shared pointer is read
+        record_->state.exchange((epoch << 1) | 1, std::memory_order_seq_cst);
+    }
+};
+
+inline epoch_domain::guard epoch_domain::pin() { return guard(this, acquire_record()); }
+
+}  // namespace learn
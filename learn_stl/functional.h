@@ -0,0 +1,315 @@
+#pragma once
+
+#include <cstdint>
+
+#include <functional>
+#include <new>
+#include <type_traits>
+
+#include "type_traits.h"
+#include "utility.h"
+
+namespace learn {
+namespace detail {
+inline constexpr std::size_t function_buffer_size = 3 * sizeof(void*);
+inline constexpr std::size_t function_buffer_align = alignof(void*);
+
+template <typename Callable, std::size_t Capacity, std::size_t Alignment>
+inline constexpr bool function_fits_inline = sizeof(Callable) <= Capacity &&
+                                             Alignment % alignof(Callable) == 0 &&
+                                             std::is_nothrow_move_constructible<Callable>::value;
+
+// std::invoke converted to Result, discarding the callable's result when Result is void
+template <typename Result, class Callable, class... Args>
+Result invoke_r(Callable&& callable, Args&&... args) {
+    if constexpr (std::is_void<Result>::value) {
+        std::invoke(::learn::forward<Callable>(callable), ::learn::forward<Args>(args)...);
+    } else {
+        return std::invoke(::learn::forward<Callable>(callable), ::learn::forward<Args>(args)...);
+    }
+}
+
+// the shared implementation of function and inplace_function; callables which fit are stored
+// in the buffer, others are heap allocated when HeapFallback is set and rejected otherwise
+template <typename Signature, std::size_t Capacity, std::size_t Alignment, bool HeapFallback>
+class basic_function;
+
+template <typename Result, typename... Args, std::size_t Capacity, std::size_t Alignment,
+          bool HeapFallback>
+class basic_function<Result(Args...), Capacity, Alignment, HeapFallback> {
+    template <typename Callable>
+    using enable_if_callable =
+        std::enable_if_t<!std::is_same<std::decay_t<Callable>, basic_function>::value &&
+                         std::is_invocable_r<Result, std::decay_t<Callable>&, Args...>::value>;
+
+  public:
+    using result_type = Result;
+
+    basic_function() noexcept = default;
+    basic_function(std::nullptr_t) noexcept {}
+
+    template <typename Callable, typename = enable_if_callable<Callable>>
+    basic_function(Callable&& callable) {
+        using Value = std::decay_t<Callable>;
+        using Passed = std::remove_reference_t<Callable>;
+
+        // a function reference decays to a pointer but can never be null
+        if constexpr (std::is_pointer<Passed>::value || std::is_member_pointer<Passed>::value) {
+            if (!callable) {
+                return;
+            }
+        }
+
+        Manager<Value>::create(storage_, ::learn::forward<Callable>(callable));
+        vtable_ = &vtable_for<Value>;
+        invoke_ = &Manager<Value>::invoke;
+    }
+
+    basic_function(const basic_function& other) {
+        if (other) {
+            other.vtable_->copy(other.storage_, storage_);
+            vtable_ = other.vtable_;
+            invoke_ = other.invoke_;
+        }
+    }
+
+    basic_function(basic_function&& other) noexcept { move_from(other); }
+
+    ~basic_function() { reset(); }
+
+    basic_function& operator=(const basic_function& other) {
+        basic_function(other).swap(*this);
+        return *this;
+    }
+
+    basic_function& operator=(basic_function&& other) noexcept {
+        basic_function(::learn::move(other)).swap(*this);
+        return *this;
+    }
+
+    basic_function& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    template <typename Callable, typename = enable_if_callable<Callable>>
+    basic_function& operator=(Callable&& callable) {
+        basic_function(::learn::forward<Callable>(callable)).swap(*this);
+        return *this;
+    }
+
+    void swap(basic_function& other) noexcept {
+        if (this == &other) {
+            return;
+        }
+
+        basic_function tmp(::learn::move(other));
+        other.move_from(*this);
+        move_from(tmp);
+    }
+
+    explicit operator bool() const noexcept { return invoke_ != nullptr; }
+
+    Result operator()(Args... args) const {
+        if (!invoke_) {
+            throw std::bad_function_call();
+        }
+
+        return invoke_(storage_, ::learn::forward<Args>(args)...);
+    }
+
+  private:
+    union Storage {
+        void* ptr;
+        typename aligned_storage<Capacity, Alignment>::type buffer;
+    };
+
+    // the invoker is kept in the function itself rather than the vtable, so a call is a single
+    // indirect jump
+    using Invoker = Result (*)(const Storage&, Args&&...);
+
+    struct VTable {
+        void (*copy)(const Storage& self, Storage& other);
+        void (*move)(Storage& self, Storage& other) noexcept;
+        void (*destroy)(Storage& self) noexcept;
+    };
+
+    template <typename Callable>
+    struct InlineManager {
+        template <typename... CtorArgs>
+        static void create(Storage& storage, CtorArgs&&... args) {
+            ::new (static_cast<void*>(&storage.buffer))
+                Callable(::learn::forward<CtorArgs>(args)...);
+        }
+
+        static Callable* access(const Storage& storage) noexcept {
+            const auto* buffer = &storage.buffer;
+            return const_cast<Callable*>(reinterpret_cast<const Callable*>(buffer));
+        }
+
+        static Result invoke(const Storage& storage, Args&&... args) {
+            return invoke_r<Result>(*access(storage), ::learn::forward<Args>(args)...);
+        }
+
+        static void copy(const Storage& self, Storage& other) { create(other, *access(self)); }
+
+        static void move(Storage& self, Storage& other) noexcept {
+            create(other, ::learn::move(*access(self)));
+            access(self)->~Callable();
+        }
+
+        static void destroy(Storage& self) noexcept { access(self)->~Callable(); }
+    };
+
+    template <typename Callable>
+    struct HeapManager {
+        template <typename... CtorArgs>
+        static void create(Storage& storage, CtorArgs&&... args) {
+            storage.ptr = new Callable(::learn::forward<CtorArgs>(args)...);
+        }
+
+        static Callable* access(const Storage& storage) noexcept {
+            return static_cast<Callable*>(storage.ptr);
+        }
+
+        static Result invoke(const Storage& storage, Args&&... args) {
+            return invoke_r<Result>(*access(storage), ::learn::forward<Args>(args)...);
+        }
+
+        static void copy(const Storage& self, Storage& other) { create(other, *access(self)); }
+
+        static void move(Storage& self, Storage& other) noexcept { other.ptr = self.ptr; }
+
+        static void destroy(Storage& self) noexcept { delete access(self); }
+    };
+
+    template <typename Callable>
+    static constexpr bool fits_inline = function_fits_inline<Callable, Capacity, Alignment>;
+
+    template <typename Callable>
+    static constexpr bool check_capacity() {
+        static_assert(HeapFallback || fits_inline<Callable>,
+                      "callable is too large for this inplace_function's capacity, or its move "
+                      "constructor can throw");
+        return fits_inline<Callable>;
+    }
+
+    template <typename Callable>
+    using Manager = std::conditional_t<check_capacity<Callable>(), InlineManager<Callable>,
+                                       HeapManager<Callable>>;
+
+    template <typename Callable>
+    static constexpr VTable vtable_for = {
+        &Manager<Callable>::copy,
+        &Manager<Callable>::move,
+        &Manager<Callable>::destroy,
+    };
+
+    void reset() noexcept {
+        if (vtable_) {
+            vtable_->destroy(storage_);
+            vtable_ = nullptr;
+            invoke_ = nullptr;
+        }
+    }
+
+    // this must be empty, other is left empty
+    void move_from(basic_function& other) noexcept {
+        if (other.vtable_) {
+            other.vtable_->move(other.storage_, storage_);
+            vtable_ = other.vtable_;
+            invoke_ = other.invoke_;
+            other.vtable_ = nullptr;
+            other.invoke_ = nullptr;
+        }
+    }
+
+    const VTable* vtable_ = nullptr;
+    Invoker invoke_ = nullptr;
+    Storage storage_;
+};
+}  // namespace detail
+
+// type-erased callable, callables up to three pointers in size are stored without allocating
+template <typename Signature>
+class function : public detail::basic_function<Signature, detail::function_buffer_size,
+                                               detail::function_buffer_align, true> {
+    using Base = detail::basic_function<Signature, detail::function_buffer_size,
+                                        detail::function_buffer_align, true>;
+
+  public:
+    using Base::Base;
+    using Base::operator=;
+};
+
+// never allocates, storing a callable which doesn't fit in Capacity is a compile error
+template <typename Signature, std::size_t Capacity = 4 * sizeof(void*),
+          std::size_t Alignment = alignof(void*)>
+class inplace_function : public detail::basic_function<Signature, Capacity, Alignment, false> {
+    using Base = detail::basic_function<Signature, Capacity, Alignment, false>;
+
+  public:
+    using Base::Base;
+    using Base::operator=;
+};
+
+template <typename Signature>
+void swap(function<Signature>& lhs, function<Signature>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename Signature, std::size_t Capacity, std::size_t Alignment>
+void swap(inplace_function<Signature, Capacity, Alignment>& lhs,
+          inplace_function<Signature, Capacity, Alignment>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// a non-owning reference to a callable, two pointers which are cheap to pass by value; the
+// callable must outlive the function_ref
+template <typename Signature>
+class function_ref;
+
+template <typename Result, typename... Args>
+class function_ref<Result(Args...)> {
+  public:
+    template <typename Callable,
+              typename = std::enable_if_t<
+                  !std::is_same<std::decay_t<Callable>, function_ref>::value &&
+                  std::is_invocable_r<Result, Callable&, Args...>::value>>
+    function_ref(Callable&& callable) noexcept {
+        using Value = std::remove_reference_t<Callable>;
+
+        if constexpr (std::is_function<Value>::value) {
+            callable_.function = reinterpret_cast<void (*)()>(&callable);
+            invoke_ = [](Erased callable, Args... args) -> Result {
+                return detail::invoke_r<Result>(reinterpret_cast<Value*>(callable.function),
+                                                ::learn::forward<Args>(args)...);
+            };
+        } else {
+            callable_.object = const_cast<void*>(static_cast<const void*>(&callable));
+            invoke_ = [](Erased callable, Args... args) -> Result {
+                return detail::invoke_r<Result>(*static_cast<Value*>(callable.object),
+                                                ::learn::forward<Args>(args)...);
+            };
+        }
+    }
+
+    function_ref(const function_ref& other) noexcept = default;
+    function_ref& operator=(const function_ref& other) noexcept = default;
+
+    Result operator()(Args... args) const {
+        return invoke_(callable_, ::learn::forward<Args>(args)...);
+    }
+
+  private:
+    // function pointers can't portably be stored in a void*
+    union Erased {
+        void* object;
+        void (*function)();
+    };
+
+    Erased callable_;
+    Result (*invoke_)(Erased, Args...);
+};
+
+}  // namespace learn
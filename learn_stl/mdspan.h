@@ -0,0 +1,438 @@
+#pragma once
+
+#include <cstdlib>
+
+#include <limits>
+#include <type_traits>
+
+#include "array.h"
+#include "utility.h"
+
+namespace learn {
+inline constexpr std::size_t dynamic_extent = std::numeric_limits<std::size_t>::max();
+
+namespace detail {
+// the sizes of the dynamic extents, a base of extents so that it's empty when they're all static
+template <std::size_t Count>
+struct extents_storage {
+    constexpr extents_storage() noexcept = default;
+    template <typename... Dynamic>
+    constexpr explicit extents_storage(Dynamic... dynamic) noexcept
+        : dynamic_{static_cast<std::size_t>(dynamic)...} {}
+
+    array<std::size_t, Count> dynamic_{};
+};
+
+template <>
+struct extents_storage<0> {};
+}  // namespace detail
+
+// the size of each dimension, each either fixed at compile time or dynamic_extent and given at
+// run time; only the dynamic ones take up any space, and fully static extents are an empty class
+template <std::size_t... Extents>
+class extents : private detail::extents_storage<((Extents == dynamic_extent) + ... + 0)> {
+    using Storage = detail::extents_storage<((Extents == dynamic_extent) + ... + 0)>;
+
+  public:
+    using index_type = std::size_t;
+
+    static constexpr std::size_t rank() noexcept { return sizeof...(Extents); }
+    static constexpr std::size_t rank_dynamic() noexcept {
+        return ((Extents == dynamic_extent) + ... + 0);
+    }
+
+    static constexpr std::size_t static_extent(std::size_t r) noexcept {
+        constexpr std::size_t values[] = {Extents..., 0};
+        return values[r];
+    }
+
+    constexpr extents() noexcept = default;
+
+    // one size for each dynamic extent, in order
+    template <typename... Dynamic,
+              typename = std::enable_if_t<sizeof...(Dynamic) == rank_dynamic() &&
+                                          sizeof...(Dynamic) != 0 &&
+                                          (std::is_integral<Dynamic>::value && ...)>>
+    constexpr explicit extents(Dynamic... dynamic) noexcept : Storage(dynamic...) {}
+
+    constexpr index_type extent(std::size_t r) const noexcept {
+        if constexpr (rank_dynamic() != 0) {
+            if (static_extent(r) == dynamic_extent) {
+                return this->dynamic_[dynamic_index(r)];
+            }
+        }
+
+        return static_extent(r);
+    }
+
+    // the number of elements
+    constexpr index_type size() const noexcept {
+        index_type result = 1;
+        for (std::size_t r = 0; r < rank(); ++r) {
+            result *= extent(r);
+        }
+
+        return result;
+    }
+
+  private:
+    static constexpr std::size_t dynamic_index(std::size_t r) noexcept {
+        std::size_t index = 0;
+        for (std::size_t i = 0; i < r; ++i) {
+            index += static_extent(i) == dynamic_extent;
+        }
+
+        return index;
+    }
+};
+
+template <std::size_t... LhsExtents, std::size_t... RhsExtents>
+constexpr bool operator==(const extents<LhsExtents...>& lhs, const extents<RhsExtents...>& rhs) {
+    if constexpr (sizeof...(LhsExtents) != sizeof...(RhsExtents)) {
+        return false;
+    } else {
+        for (std::size_t r = 0; r < sizeof...(LhsExtents); ++r) {
+            if (lhs.extent(r) != rhs.extent(r)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+namespace detail {
+template <std::size_t>
+inline constexpr std::size_t always_dynamic = dynamic_extent;
+
+template <typename Sequence>
+struct make_dextents;
+
+template <std::size_t... Indices>
+struct make_dextents<index_sequence<Indices...>> {
+    using type = extents<always_dynamic<Indices>...>;
+};
+}  // namespace detail
+
+// Rank extents, all of them dynamic
+template <std::size_t Rank>
+using dextents = typename detail::make_dextents<typename make_index_sequence<Rank>::type>::type;
+
+// ------------------------------------------------------------------------------------
+// layouts, each maps a multidimensional index to an offset into the underlying storage
+
+// row-major, the last index is contiguous
+struct layout_right {
+    template <class Extents>
+    class mapping {
+      public:
+        using extents_type = Extents;
+        using index_type = std::size_t;
+
+        constexpr mapping() noexcept = default;
+        constexpr explicit mapping(const Extents& extents) noexcept : extents_(extents) {}
+
+        constexpr const Extents& extents() const noexcept { return extents_; }
+        constexpr index_type required_span_size() const noexcept { return extents_.size(); }
+
+        template <typename... Indices>
+        constexpr index_type operator()(Indices... indices) const noexcept {
+            const index_type values[] = {static_cast<index_type>(indices)..., 0};
+
+            index_type offset = 0;
+            for (std::size_t r = 0; r < Extents::rank(); ++r) {
+                offset = offset * extents_.extent(r) + values[r];
+            }
+
+            return offset;
+        }
+
+        constexpr index_type stride(std::size_t r) const noexcept {
+            index_type result = 1;
+            for (std::size_t i = r + 1; i < Extents::rank(); ++i) {
+                result *= extents_.extent(i);
+            }
+
+            return result;
+        }
+
+      private:
+        Extents extents_;
+    };
+};
+
+// column-major, the first index is contiguous
+struct layout_left {
+    template <class Extents>
+    class mapping {
+      public:
+        using extents_type = Extents;
+        using index_type = std::size_t;
+
+        constexpr mapping() noexcept = default;
+        constexpr explicit mapping(const Extents& extents) noexcept : extents_(extents) {}
+
+        constexpr const Extents& extents() const noexcept { return extents_; }
+        constexpr index_type required_span_size() const noexcept { return extents_.size(); }
+
+        template <typename... Indices>
+        constexpr index_type operator()(Indices... indices) const noexcept {
+            const index_type values[] = {static_cast<index_type>(indices)..., 0};
+
+            index_type offset = 0;
+            for (std::size_t r = Extents::rank(); r-- > 0;) {
+                offset = offset * extents_.extent(r) + values[r];
+            }
+
+            return offset;
+        }
+
+        constexpr index_type stride(std::size_t r) const noexcept {
+            index_type result = 1;
+            for (std::size_t i = 0; i < r; ++i) {
+                result *= extents_.extent(i);
+            }
+
+            return result;
+        }
+
+      private:
+        Extents extents_;
+    };
+};
+
+// an arbitrary stride for each dimension, e.g. every other column of a row-major matrix
+struct layout_stride {
+    template <class Extents>
+    class mapping {
+      public:
+        using extents_type = Extents;
+        using index_type = std::size_t;
+        using strides_type = array<index_type, Extents::rank()>;
+
+        constexpr mapping() noexcept = default;
+        constexpr mapping(const Extents& extents, const strides_type& strides) noexcept
+            : extents_(extents), strides_(strides) {}
+
+        constexpr const Extents& extents() const noexcept { return extents_; }
+
+        // one past the furthest offset any index maps to
+        constexpr index_type required_span_size() const noexcept {
+            index_type result = 1;
+            for (std::size_t r = 0; r < Extents::rank(); ++r) {
+                if (extents_.extent(r) == 0) {
+                    return 0;
+                }
+                result += (extents_.extent(r) - 1) * strides_[r];
+            }
+
+            return result;
+        }
+
+        template <typename... Indices>
+        constexpr index_type operator()(Indices... indices) const noexcept {
+            const index_type values[] = {static_cast<index_type>(indices)..., 0};
+
+            index_type offset = 0;
+            for (std::size_t r = 0; r < Extents::rank(); ++r) {
+                offset += values[r] * strides_[r];
+            }
+
+            return offset;
+        }
+
+        constexpr index_type stride(std::size_t r) const noexcept { return strides_[r]; }
+
+      private:
+        Extents extents_;
+        strides_type strides_{};
+    };
+};
+
+// blocked storage, the index space is cut into tiles of Tiles... elements which are each stored
+// contiguously and row-major, and the tiles themselves are in row-major order. A sweep along any
+// dimension then touches one tile's cache lines at a time. Tiles at the far edges are padded out
+// to full size, so required_span_size can exceed the number of elements
+template <std::size_t... Tiles>
+struct layout_tiled {
+    static_assert(((Tiles > 0) && ...), "tiles must have at least one element in each dimension");
+
+    static constexpr std::size_t tile_extent(std::size_t r) noexcept {
+        constexpr std::size_t values[] = {Tiles..., 0};
+        return values[r];
+    }
+
+    static constexpr std::size_t tile_size = (Tiles * ... * 1);
+
+    template <class Extents>
+    class mapping {
+        static_assert(sizeof...(Tiles) == Extents::rank(), "one tile extent per dimension");
+
+      public:
+        using extents_type = Extents;
+        using index_type = std::size_t;
+
+        constexpr mapping() noexcept = default;
+        constexpr explicit mapping(const Extents& extents) noexcept : extents_(extents) {
+            for (std::size_t r = 0; r < Extents::rank(); ++r) {
+                tile_counts_[r] = (extents_.extent(r) + tile_extent(r) - 1) / tile_extent(r);
+            }
+        }
+
+        constexpr const Extents& extents() const noexcept { return extents_; }
+
+        constexpr index_type required_span_size() const noexcept {
+            index_type tiles = 1;
+            for (std::size_t r = 0; r < Extents::rank(); ++r) {
+                tiles *= tile_counts_[r];
+            }
+
+            return tiles * tile_size;
+        }
+
+        // tile extents are constants, so with powers of two the divisions become shifts
+        template <typename... Indices>
+        constexpr index_type operator()(Indices... indices) const noexcept {
+            const index_type values[] = {static_cast<index_type>(indices)..., 0};
+
+            index_type tile = 0;
+            index_type within = 0;
+            for (std::size_t r = 0; r < Extents::rank(); ++r) {
+                tile = tile * tile_counts_[r] + values[r] / tile_extent(r);
+                within = within * tile_extent(r) + values[r] % tile_extent(r);
+            }
+
+            return tile * tile_size + within;
+        }
+
+      private:
+        Extents extents_;
+        array<index_type, Extents::rank()> tile_counts_{};
+    };
+};
+
+// ------------------------------------------------------------------------------------
+
+// a non-owning multidimensional view of contiguous storage, e.g. a learn::vector's data()
+//   learn::mdspan<double, learn::dextents<2>> matrix(values.data(), rows, cols);
+//   matrix(i, j) = 1.0;
+template <typename T, class Extents, class Layout = layout_right>
+class mdspan {
+  public:
+    using element_type = T;
+    using extents_type = Extents;
+    using layout_type = Layout;
+    using mapping_type = typename Layout::template mapping<Extents>;
+    using index_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+
+    constexpr mdspan() noexcept = default;
+
+    // the dynamic extents, in order
+    template <typename... Dynamic,
+              typename = std::enable_if_t<(std::is_integral<Dynamic>::value && ...)>>
+    constexpr explicit mdspan(pointer data, Dynamic... dynamic) noexcept
+        : data_(data), mapping_(Extents(dynamic...)) {}
+
+    constexpr mdspan(pointer data, const Extents& extents) noexcept
+        : data_(data), mapping_(extents) {}
+    constexpr mdspan(pointer data, const mapping_type& mapping) noexcept
+        : data_(data), mapping_(mapping) {}
+
+    static constexpr std::size_t rank() noexcept { return Extents::rank(); }
+
+    constexpr const Extents& extents() const noexcept { return mapping_.extents(); }
+    constexpr index_type extent(std::size_t r) const noexcept { return extents().extent(r); }
+    constexpr index_type size() const noexcept { return extents().size(); }
+    constexpr bool empty() const noexcept { return size() == 0; }
+
+    constexpr index_type stride(std::size_t r) const noexcept { return mapping_.stride(r); }
+
+    template <typename... Indices>
+    constexpr reference operator()(Indices... indices) const noexcept {
+        static_assert(sizeof...(Indices) == Extents::rank(), "one index per dimension");
+        return data_[mapping_(static_cast<index_type>(indices)...)];
+    }
+
+    constexpr pointer data() const noexcept { return data_; }
+    constexpr const mapping_type& mapping() const noexcept { return mapping_; }
+
+  private:
+    pointer data_ = nullptr;
+    mapping_type mapping_;
+};
+
+// ------------------------------------------------------------------------------------
+// tile-aware iteration, visiting a whole tile before moving on keeps its working set in cache,
+// e.g. for a stencil or a transpose, whatever the layout being read and written
+
+namespace detail {
+template <std::size_t Dim, std::size_t Rank, class Extents, class Fn>
+constexpr void for_each_tile(const Extents& extents, const array<std::size_t, Rank>& tile,
+                             array<std::size_t, Rank>& first, array<std::size_t, Rank>& last,
+                             Fn& fn) {
+    if constexpr (Dim == Rank) {
+        fn(static_cast<const array<std::size_t, Rank>&>(first),
+           static_cast<const array<std::size_t, Rank>&>(last));
+    } else {
+        const std::size_t extent = extents.extent(Dim);
+        for (first[Dim] = 0; first[Dim] < extent; first[Dim] += tile[Dim]) {
+            last[Dim] = (extent - first[Dim] < tile[Dim]) ? extent : first[Dim] + tile[Dim];
+            for_each_tile<Dim + 1>(extents, tile, first, last, fn);
+        }
+    }
+}
+
+template <class Fn, std::size_t Rank, std::size_t... Indices>
+constexpr void call_with_index(Fn& fn, const array<std::size_t, Rank>& index,
+                               index_sequence<Indices...>) {
+    fn(index[Indices]...);
+}
+
+template <std::size_t Dim, std::size_t Rank, class Fn>
+constexpr void for_each_index(const array<std::size_t, Rank>& first,
+                              const array<std::size_t, Rank>& last,
+                              array<std::size_t, Rank>& index, Fn& fn) {
+    if constexpr (Dim == Rank) {
+        call_with_index(fn, index, typename make_index_sequence<Rank>::type());
+    } else {
+        for (index[Dim] = first[Dim]; index[Dim] < last[Dim]; ++index[Dim]) {
+            for_each_index<Dim + 1>(first, last, index, fn);
+        }
+    }
+}
+}  // namespace detail
+
+// calls fn(first, last) for each tile of Tiles... indices, in row-major order, where first and
+// last are learn::arrays of each dimension's first index and one past its last; the tiles at the
+// far edges are cut short
+template <std::size_t... Tiles, class Extents, class Fn>
+constexpr void for_each_tile(const Extents& extents, Fn fn) {
+    static_assert(sizeof...(Tiles) == Extents::rank(), "one tile extent per dimension");
+    static_assert(((Tiles > 0) && ...), "tiles must have at least one element in each dimension");
+
+    constexpr std::size_t rank = Extents::rank();
+    if (extents.size() == 0) {
+        return;
+    }
+
+    const array<std::size_t, rank> tile = {Tiles...};
+    array<std::size_t, rank> first{};
+    array<std::size_t, rank> last{};
+    detail::for_each_tile<0>(extents, tile, first, last, fn);
+}
+
+// calls fn(i, j, ...) for every index, tile by tile, and row-major within each tile
+template <std::size_t... Tiles, class Extents, class Fn>
+constexpr void for_each_index_tiled(const Extents& extents, Fn fn) {
+    constexpr std::size_t rank = Extents::rank();
+
+    for_each_tile<Tiles...>(extents, [&fn](const array<std::size_t, rank>& first,
+                                           const array<std::size_t, rank>& last) {
+        array<std::size_t, rank> index = first;
+        detail::for_each_index<0>(first, last, index, fn);
+    });
+}
+
+}  // namespace learn
@@ -1,12 +1,21 @@
 #pragma once
 
+#include <cstdint>
 #include <new>
 #include <type_traits>
 
 #include "utility.h"
 
+#ifdef LEARN_STL_THREAD_CACHE
+#include "thread_cache.h"
+#endif
+
 namespace learn {
 
+// the size of a cache line on the platforms we care about, used to keep data touched by
+// different threads on separate lines and to align buffers for SIMD loads
+inline constexpr std::size_t cache_line_size = 64;
+
 template <class T>
 constexpr T* addressof(T& v) {
     return reinterpret_cast<T*>(&const_cast<char&>(reinterpret_cast<const volatile char&>(v)));
@@ -27,6 +36,18 @@ struct default_delete {
     }
 };
 
+template <typename Object>
+struct default_delete<Object[]> {
+    constexpr default_delete() noexcept = default;
+
+    void operator()(Object* ptr) const noexcept {
+        static_assert(sizeof(Object) > 0, "default_delete can not delete incomplete type");
+        static_assert(!std::is_void<Object>::value,
+                      "default_delete can not delete incomplete type");
+        delete[] ptr;
+    }
+};
+
 template <class T, class Deleter = default_delete<T>>
 class unique_ptr {
   public:
@@ -45,7 +66,10 @@ class unique_ptr {
         return *this;
     }
 
-    unique_ptr& operator=(std::nullptr_t) noexcept { reset(nullptr); }
+    unique_ptr& operator=(std::nullptr_t) noexcept {
+        reset(nullptr);
+        return *this;
+    }
 
     void reset(pointer ptr = pointer()) noexcept {
         if (pointer_) {
@@ -62,17 +86,114 @@ class unique_ptr {
 
     pointer get() const noexcept { return pointer_; }
 
+    pointer release() noexcept {
+        pointer ptr = pointer_;
+        pointer_ = nullptr;
+        return ptr;
+    }
+
     explicit operator bool() const noexcept { return bool(pointer_); }
 
   private:
     pointer pointer_ = nullptr;
 };
 
+template <class T, class Deleter>
+class unique_ptr<T[], Deleter> {
+  public:
+    using element_type = T;
+    using pointer = T*;
+    using deleter_type = Deleter;
+
+    unique_ptr() noexcept = default;
+    explicit unique_ptr(pointer p) noexcept : pointer_(p) {}
+
+    unique_ptr(unique_ptr&& other) : pointer_(other.pointer_) { other.pointer_ = nullptr; }
+
+    unique_ptr& operator=(unique_ptr&& other) {
+        reset(other.pointer_);
+        other.pointer_ = nullptr;
+        return *this;
+    }
+
+    unique_ptr& operator=(std::nullptr_t) noexcept {
+        reset(nullptr);
+        return *this;
+    }
+
+    void reset(pointer ptr = pointer()) noexcept {
+        if (pointer_) {
+            deleter_type()(pointer_);
+        }
+
+        pointer_ = ptr;
+    }
+
+    ~unique_ptr() { reset(); }
+
+    T& operator[](std::size_t index) const { return pointer_[index]; }
+
+    pointer get() const noexcept { return pointer_; }
+
+    pointer release() noexcept {
+        pointer ptr = pointer_;
+        pointer_ = nullptr;
+        return ptr;
+    }
+
+    explicit operator bool() const noexcept { return bool(pointer_); }
+
+  private:
+    pointer pointer_ = nullptr;
+};
+
+namespace detail {
+template <typename Value>
+struct is_unbounded_array : std::false_type {};
+
+template <typename Value>
+struct is_unbounded_array<Value[]> : std::true_type {};
+
+template <typename Value>
+struct is_bounded_array : std::bool_constant<std::is_array<Value>::value &&
+                                             !is_unbounded_array<Value>::value> {};
+}  // namespace detail
+
 template <typename Value, class Deleter = default_delete<Value>, typename... Args>
-unique_ptr<Value, Deleter> make_unique(Args&&... args) {
-    return unique_ptr<Value, Deleter>(new Value(forward<Args>(args)...));
+std::enable_if_t<!std::is_array<Value>::value, unique_ptr<Value, Deleter>> make_unique(
+    Args&&... args) {
+    return unique_ptr<Value, Deleter>(new Value(::learn::forward<Args>(args)...));
+}
+
+// value-initialises every element, so arrays of scalars are zero-filled
+template <typename Value, class Deleter = default_delete<Value>>
+std::enable_if_t<detail::is_unbounded_array<Value>::value, unique_ptr<Value, Deleter>> make_unique(
+    std::size_t n) {
+    using Element = std::remove_extent_t<Value>;
+    return unique_ptr<Value, Deleter>(new Element[n]());
+}
+
+template <typename Value, typename... Args>
+std::enable_if_t<detail::is_bounded_array<Value>::value> make_unique(Args&&... args) = delete;
+
+// default-initialises instead, trivial types are left uninitialised for the caller to overwrite
+template <typename Value, class Deleter = default_delete<Value>>
+std::enable_if_t<!std::is_array<Value>::value, unique_ptr<Value, Deleter>>
+make_unique_for_overwrite() {
+    return unique_ptr<Value, Deleter>(new Value);
+}
+
+template <typename Value, class Deleter = default_delete<Value>>
+std::enable_if_t<detail::is_unbounded_array<Value>::value, unique_ptr<Value, Deleter>>
+make_unique_for_overwrite(std::size_t n) {
+    using Element = std::remove_extent_t<Value>;
+    return unique_ptr<Value, Deleter>(new Element[n]);
 }
 
+template <typename Value, typename... Args>
+std::enable_if_t<detail::is_bounded_array<Value>::value> make_unique_for_overwrite(
+    Args&&... args) = delete;
+
 template <class T>
 struct allocator {
     using value_type = T;
@@ -93,6 +214,12 @@ struct allocator {
         const auto num_bytes = size_type{n * sizeof(T)};
         const auto alignment = std::align_val_t{alignof(T)};
 
+#ifdef LEARN_STL_THREAD_CACHE
+        if constexpr (alignof(T) <= thread_caching_heap::max_alignment) {
+            return static_cast<T*>(thread_caching_heap::allocate(num_bytes));
+        }
+#endif
+
         return static_cast<T*>(::operator new(num_bytes, alignment));
     }
 
@@ -100,6 +227,13 @@ struct allocator {
         const auto num_bytes = size_type{n * sizeof(T)};
         const auto alignment = std::align_val_t{alignof(T)};
 
+#ifdef LEARN_STL_THREAD_CACHE
+        if constexpr (alignof(T) <= thread_caching_heap::max_alignment) {
+            thread_caching_heap::deallocate(p, num_bytes);
+            return;
+        }
+#endif
+
         ::operator delete(p, alignment);
     }
 
@@ -116,4 +250,68 @@ bool operator!=(const allocator<T1>& lhs, const allocator<T2>& rhs) noexcept {
     return false;
 }
 
-}  // namespace learn
\ No newline at end of file
+template <std::size_t Alignment, class T>
+[[nodiscard]] constexpr T* assume_aligned(T* ptr) {
+    static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0,
+                  "alignment must be a power of two");
+    return static_cast<T*>(__builtin_assume_aligned(ptr, Alignment));
+}
+
+template <class T, std::size_t Alignment = cache_line_size>
+struct aligned_allocator {
+    static_assert((Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+    static_assert(Alignment >= alignof(T), "alignment must be at least alignof(T)");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    static constexpr size_type alignment = Alignment;
+
+    // allocator_traits can't deduce rebind for a template with a non-type parameter
+    template <class U>
+    struct rebind {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    aligned_allocator() noexcept = default;
+    aligned_allocator(const aligned_allocator& other) noexcept = default;
+
+    template <class U>
+    aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {};
+
+    ~aligned_allocator() = default;
+
+    value_type* allocate(size_type n) {
+        const auto alignment = std::align_val_t{Alignment};
+        return static_cast<T*>(::operator new(num_bytes(n), alignment));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        const auto alignment = std::align_val_t{Alignment};
+        ::operator delete(p, num_bytes(n), alignment);
+    }
+
+    size_type max_size() const noexcept { return size_type(~0) / sizeof(T); }
+
+  private:
+    // rounded up to a whole number of alignment blocks so kernels can load the tail with a full
+    // width vector, and the block after it is never shared with another allocation
+    static size_type num_bytes(size_type n) {
+        return (n * sizeof(T) + Alignment - 1) & ~(Alignment - 1);
+    }
+};
+
+template <class T1, std::size_t A1, class T2, std::size_t A2>
+bool operator==(const aligned_allocator<T1, A1>&, const aligned_allocator<T2, A2>&) noexcept {
+    return A1 == A2;
+}
+
+template <class T1, std::size_t A1, class T2, std::size_t A2>
+bool operator!=(const aligned_allocator<T1, A1>&, const aligned_allocator<T2, A2>&) noexcept {
+    return A1 != A2;
+}
+
+}  // namespace learn
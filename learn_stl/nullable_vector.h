@@ -0,0 +1,233 @@
+#pragma once
+
+#include <cstdint>
+
+#include <type_traits>
+
+#include "optional.h"
+#include "utility.h"
+#include "vector.h"
+
+namespace learn {
+namespace detail {
+inline constexpr std::size_t validity_word_bits = 64;
+
+inline std::size_t popcount(std::uint64_t word) noexcept {
+    return static_cast<std::size_t>(__builtin_popcountll(word));
+}
+
+inline std::size_t lowest_set_bit(std::uint64_t word) noexcept {
+    return static_cast<std::size_t>(__builtin_ctzll(word));
+}
+}  // namespace detail
+
+// a column of optional values, stored as a dense vector of values beside a bitmap saying which
+// are valid; null slots hold a value initialised T, so the values can be looped over without
+// checking each one
+template <typename T>
+class nullable_vector {
+    static_assert(std::is_default_constructible<T>::value,
+                  "null slots of a nullable_vector hold a default constructed value");
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using word_type = std::uint64_t;
+
+    static constexpr size_type word_bits = detail::validity_word_bits;
+
+    nullable_vector() = default;
+
+    // element access
+
+    bool is_valid(size_type index) const noexcept {
+        return (validity_[index / word_bits] >> (index % word_bits)) & 1u;
+    }
+
+    bool is_null(size_type index) const noexcept { return !is_valid(index); }
+
+    optional<T> get(size_type index) const {
+        if (!is_valid(index)) {
+            return {};
+        }
+
+        return values_[index];
+    }
+
+    // unchecked, a null slot holds a value initialised T
+    T& value(size_type index) noexcept { return values_[index]; }
+    const T& value(size_type index) const noexcept { return values_[index]; }
+
+    // the values, including those in null slots
+    const vector<T>& values() const noexcept { return values_; }
+
+    // bit i % word_bits of word i / word_bits is set if element i is valid, bits past size() are
+    // always clear
+    const vector<word_type>& validity() const noexcept { return validity_; }
+
+    // capacity
+
+    size_type size() const noexcept { return values_.size(); }
+    bool empty() const noexcept { return values_.size() == 0; }
+
+    size_type null_count() const noexcept;
+
+    void reserve(size_type new_capacity) {
+        values_.reserve(new_capacity);
+        validity_.reserve((new_capacity + word_bits - 1) / word_bits);
+    }
+
+    // modifiers
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        T& value = values_.emplace_back(::learn::forward<Args>(args)...);
+        append_bit(true);
+        return value;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(::learn::move(value)); }
+
+    void push_back(const optional<T>& value) {
+        if (value) {
+            emplace_back(*value);
+        } else {
+            push_null();
+        }
+    }
+
+    void push_null() {
+        values_.emplace_back();
+        append_bit(false);
+    }
+
+    void set(size_type index, const T& value) {
+        values_[index] = value;
+        validity_[index / word_bits] |= word_type(1) << (index % word_bits);
+    }
+
+    void set_null(size_type index) {
+        values_[index] = T();
+        validity_[index / word_bits] &= ~(word_type(1) << (index % word_bits));
+    }
+
+    void clear() {
+        values_.clear();
+        validity_.clear();
+    }
+
+  private:
+    void append_bit(bool valid) {
+        const size_type index = values_.size() - 1;
+
+        if (index % word_bits == 0) {
+            validity_.emplace_back(0);
+        }
+
+        if (valid) {
+            validity_.back() |= word_type(1) << (index % word_bits);
+        }
+    }
+
+    vector<T> values_;
+    vector<word_type> validity_;
+};
+
+template <typename T>
+typename nullable_vector<T>::size_type nullable_vector<T>::null_count() const noexcept {
+    size_type valid = 0;
+    for (const word_type word : validity_) {
+        valid += detail::popcount(word);
+    }
+
+    return size() - valid;
+}
+
+// ------------------------------------------------------------------------------------
+// null-aware algorithms, these walk the bitmap a word at a time; a word with every bit set is a
+// plain loop over 64 values, an empty word is skipped and a mixed word visits its set bits
+
+// calls fn(index, value) for every valid element in order, stopping early if fn returns false
+template <typename T, typename Function>
+bool for_each_valid(const nullable_vector<T>& column, Function fn) {
+    using word_type = typename nullable_vector<T>::word_type;
+    constexpr std::size_t word_bits = nullable_vector<T>::word_bits;
+
+    const T* values = column.values().data();
+    const auto& validity = column.validity();
+
+    for (std::size_t w = 0; w < validity.size(); ++w) {
+        word_type word = validity[w];
+        const std::size_t base = w * word_bits;
+
+        if (word == ~word_type(0)) {
+            for (std::size_t i = base; i < base + word_bits; ++i) {
+                if (!fn(i, values[i])) {
+                    return false;
+                }
+            }
+            continue;
+        }
+
+        while (word != 0) {
+            const std::size_t i = base + detail::lowest_set_bit(word);
+            if (!fn(i, values[i])) {
+                return false;
+            }
+            word &= word - 1;
+        }
+    }
+
+    return true;
+}
+
+// the number of valid elements
+template <typename T>
+std::size_t count(const nullable_vector<T>& column) noexcept {
+    return column.size() - column.null_count();
+}
+
+template <typename T, typename UnaryPredicate>
+std::size_t count_if(const nullable_vector<T>& column, UnaryPredicate fn) {
+    std::size_t matches = 0;
+    for_each_valid(column, [&](std::size_t, const T& value) {
+        matches += fn(value) ? 1 : 0;
+        return true;
+    });
+
+    return matches;
+}
+
+template <typename T, typename Result, typename BinaryOperation>
+Result reduce(const nullable_vector<T>& column, Result init, BinaryOperation op) {
+    for_each_valid(column, [&](std::size_t, const T& value) {
+        init = op(::learn::move(init), value);
+        return true;
+    });
+
+    return init;
+}
+
+// nulls are skipped, an all-null column sums to T()
+template <typename T>
+T sum(const nullable_vector<T>& column) {
+    return reduce(column, T(), [](T total, const T& value) { return total + value; });
+}
+
+// the index of the first valid element which satisfies fn, or size() if there isn't one
+template <typename T, typename UnaryPredicate>
+std::size_t find_if(const nullable_vector<T>& column, UnaryPredicate fn) {
+    std::size_t found = column.size();
+    for_each_valid(column, [&](std::size_t index, const T& value) {
+        if (fn(value)) {
+            found = index;
+            return false;
+        }
+        return true;
+    });
+
+    return found;
+}
+
+}  // namespace learn
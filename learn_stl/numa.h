@@ -0,0 +1,276 @@
+#pragma once
+
+// numa_allocator uses the Linux mbind system call and sysfs
+#if !defined(__linux__)
+#error "learn_stl/numa.h is only supported on Linux"
+#endif
+
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+#include <fstream>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include "memory.h"
+#include "vector.h"
+
+namespace learn {
+
+enum class numa_policy {
+    local,       // pages are placed on the node of the thread which first touches them
+    interleave,  // pages are spread round-robin over every online node
+    bind,        // pages are placed on a single node
+};
+
+namespace detail {
+// enough bits for the largest node count the kernel supports
+inline constexpr std::size_t numa_max_nodes = 1024;
+inline constexpr std::size_t numa_mask_bits = 8 * sizeof(unsigned long);
+
+struct numa_node_mask {
+    unsigned long bits[numa_max_nodes / numa_mask_bits] = {};
+
+    void set(int node) { bits[node / numa_mask_bits] |= 1ul << (node % numa_mask_bits); }
+};
+
+// parses the kernel's list format, e.g. "0-3,8,10-11"
+inline vector<int> parse_id_list(const std::string& text) {
+    vector<int> ids;
+    std::size_t pos = 0;
+
+    while (pos < text.size()) {
+        std::size_t end = 0;
+        const int first = std::stoi(text.substr(pos), &end);
+        pos += end;
+
+        int last = first;
+        if (pos < text.size() && text[pos] == '-') {
+            pos += 1;
+            last = std::stoi(text.substr(pos), &end);
+            pos += end;
+        }
+
+        for (int id = first; id <= last; ++id) {
+            ids.emplace_back(id);
+        }
+
+        while (pos < text.size() && (text[pos] == ',' || text[pos] == '\n')) {
+            pos += 1;
+        }
+    }
+
+    return ids;
+}
+
+inline vector<int> read_id_list(const std::string& path) {
+    std::ifstream file(path);
+    std::string text;
+
+    if (!file || !std::getline(file, text) || text.empty()) {
+        return {};
+    }
+
+    return parse_id_list(text);
+}
+
+inline const vector<int>& numa_online_nodes() {
+    static const vector<int> nodes = [] {
+        auto nodes = read_id_list("/sys/devices/system/node/online");
+        if (nodes.size() == 0) {
+            nodes.emplace_back(0);
+        }
+        return nodes;
+    }();
+
+    return nodes;
+}
+
+inline std::size_t page_size() {
+    static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+// the policy is a placement hint; if the kernel refuses it (no NUMA support, seccomp) the pages
+// are simply left wherever first-touch puts them
+inline void numa_apply_policy(void* ptr, std::size_t num_bytes, numa_policy policy, int node) {
+    if (numa_online_nodes().size() <= 1) {
+        return;
+    }
+
+    numa_node_mask mask;
+    int mode = MPOL_LOCAL;
+
+    switch (policy) {
+        case numa_policy::local:
+            ::syscall(SYS_mbind, ptr, num_bytes, MPOL_LOCAL, nullptr, 0, 0);
+            return;
+        case numa_policy::interleave:
+            mode = MPOL_INTERLEAVE;
+            for (const int online_node : numa_online_nodes()) {
+                mask.set(online_node);
+            }
+            break;
+        case numa_policy::bind:
+            mode = MPOL_BIND;
+            mask.set(node);
+            break;
+    }
+
+    ::syscall(SYS_mbind, ptr, num_bytes, mode, mask.bits, numa_max_nodes + 1, 0);
+}
+}  // namespace detail
+
+// ------------------------------------------------------------------------------------
+// topology
+
+inline std::size_t numa_node_count() { return detail::numa_online_nodes().size(); }
+
+inline vector<int> numa_cpus_of_node(int node) {
+    return detail::read_id_list("/sys/devices/system/node/node" + std::to_string(node) +
+                                "/cpulist");
+}
+
+inline int numa_node_of_cpu(int cpu) {
+    for (const int node : detail::numa_online_nodes()) {
+        for (const int node_cpu : numa_cpus_of_node(node)) {
+            if (node_cpu == cpu) {
+                return node;
+            }
+        }
+    }
+
+    return 0;
+}
+
+// the node of the cpu the calling thread is currently running on
+inline int numa_current_node() {
+    unsigned cpu = 0;
+    unsigned node = 0;
+
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return 0;
+    }
+
+    return static_cast<int>(node);
+}
+
+// the node holding the page at ptr, the page must already have been touched
+inline int numa_node_of_address(const void* ptr) {
+    if (numa_node_count() <= 1) {
+        return detail::numa_online_nodes()[0];
+    }
+
+    int node = 0;
+    if (::syscall(SYS_get_mempolicy, &node, nullptr, 0, ptr, MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+        return 0;
+    }
+
+    return node;
+}
+
+// sets the default placement policy for future allocations made by the calling thread
+inline void numa_set_thread_policy(numa_policy policy, int node = 0) {
+    if (numa_node_count() <= 1) {
+        return;
+    }
+
+    detail::numa_node_mask mask;
+
+    switch (policy) {
+        case numa_policy::local:
+            ::syscall(SYS_set_mempolicy, MPOL_LOCAL, nullptr, 0);
+            return;
+        case numa_policy::interleave:
+            for (const int online_node : detail::numa_online_nodes()) {
+                mask.set(online_node);
+            }
+            ::syscall(SYS_set_mempolicy, MPOL_INTERLEAVE, mask.bits, detail::numa_max_nodes + 1);
+            return;
+        case numa_policy::bind:
+            mask.set(node);
+            ::syscall(SYS_set_mempolicy, MPOL_BIND, mask.bits, detail::numa_max_nodes + 1);
+            return;
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// allocator
+
+template <class T>
+class numa_allocator {
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using is_always_equal = std::false_type;
+
+    explicit numa_allocator(numa_policy policy = numa_policy::local, int node = 0) noexcept
+        : policy_(policy), node_(node) {}
+
+    numa_allocator(const numa_allocator& other) noexcept = default;
+
+    template <class U>
+    numa_allocator(const numa_allocator<U>& other) noexcept
+        : policy_(other.policy()), node_(other.node()) {}
+
+    ~numa_allocator() = default;
+
+    // policies are applied per page, so allocations smaller than a page come from the global heap
+    value_type* allocate(size_type n) {
+        const auto num_bytes = size_type{n * sizeof(T)};
+
+        if (num_bytes < detail::page_size()) {
+            return allocator<T>().allocate(n);
+        }
+
+        void* ptr = ::mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                           -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        detail::numa_apply_policy(ptr, num_bytes, policy_, node_);
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        const auto num_bytes = size_type{n * sizeof(T)};
+
+        if (num_bytes < detail::page_size()) {
+            allocator<T>().deallocate(p, n);
+            return;
+        }
+
+        ::munmap(p, num_bytes);
+    }
+
+    size_type max_size() const noexcept { return size_type(~0) / sizeof(T); }
+
+    numa_policy policy() const noexcept { return policy_; }
+    int node() const noexcept { return node_; }
+
+  private:
+    numa_policy policy_;
+    int node_;
+};
+
+template <class T1, class T2>
+bool operator==(const numa_allocator<T1>& lhs, const numa_allocator<T2>& rhs) noexcept {
+    return lhs.policy() == rhs.policy() && lhs.node() == rhs.node();
+}
+
+template <class T1, class T2>
+bool operator!=(const numa_allocator<T1>& lhs, const numa_allocator<T2>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+}  // namespace learn
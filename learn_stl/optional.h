@@ -1,9 +1,12 @@
 #pragma once
 
+#include <limits>
+#include <new>
 #include <type_traits>
 #include <typeinfo>
 
 #include "algorithm.h"
+#include "type_traits.h"
 #include "utility.h"
 
 namespace learn {
@@ -11,95 +14,434 @@ namespace detail {
 
 struct dummy_t {};
 
-template <typename T>
+// a union's destructor is deleted if any member's is non-trivial, so for those types it has an
+// empty one and optional destroys the value itself
+template <typename T, bool = std::is_trivially_destructible<T>::value>
 union optional_storage {
-    static_assert(std::is_trivially_destructible<T>::value, "");
-
     dummy_t dummy_;
     T value_;
 
     constexpr optional_storage()  // null-state ctor
         : dummy_{} {}
 
-    constexpr optional_storage(T const& v)  // value ctor
-        : value_{v} {}
+    template <typename... Args>
+    constexpr explicit optional_storage(in_place_t, Args&&... args)  // value ctor
+        : value_(::learn::forward<Args>(args)...) {}
 
     ~optional_storage() = default;  // trivial dtor
 };
+
+template <typename T>
+union optional_storage<T, false> {
+    dummy_t dummy_;
+    T value_;
+
+    constexpr optional_storage() : dummy_{} {}
+
+    template <typename... Args>
+    constexpr explicit optional_storage(in_place_t, Args&&... args)
+        : value_(::learn::forward<Args>(args)...) {}
+
+    ~optional_storage() {}
+};
+
+template <typename T>
+struct optional_storage_base {
+    constexpr optional_storage_base() noexcept : has_value_(false) {}
+
+    template <typename... Args>
+    constexpr explicit optional_storage_base(in_place_t, Args&&... args)
+        : has_value_(true), storage_(in_place, ::learn::forward<Args>(args)...) {}
+
+    // this must not hold a value
+    template <typename... Args>
+    void construct(Args&&... args) {
+        ::new (static_cast<void*>(&storage_.value_)) T(::learn::forward<Args>(args)...);
+        has_value_ = true;
+    }
+
+    void destroy() noexcept {
+        if (has_value_) {
+            storage_.value_.~T();
+            has_value_ = false;
+        }
+    }
+
+    // assigns if both hold a value, otherwise constructs or destroys
+    template <class Other>
+    void assign_from(Other&& other) {
+        if (!other.has_value_) {
+            destroy();
+        } else if (has_value_) {
+            storage_.value_ = ::learn::forward<Other>(other).storage_.value_;
+        } else {
+            construct(::learn::forward<Other>(other).storage_.value_);
+        }
+    }
+
+    bool has_value_;
+    optional_storage<T> storage_;
+};
+
+// optional's special members come from a chain of bases, the same as variant's
+template <typename T, bool Trivial = std::is_trivially_destructible<T>::value>
+struct optional_destructor : optional_storage_base<T> {
+    using optional_storage_base<T>::optional_storage_base;
+};
+
+template <typename T>
+struct optional_destructor<T, false> : optional_storage_base<T> {
+    using optional_storage_base<T>::optional_storage_base;
+
+    optional_destructor() = default;
+    optional_destructor(const optional_destructor&) = default;
+    optional_destructor(optional_destructor&&) = default;
+    optional_destructor& operator=(const optional_destructor&) = default;
+    optional_destructor& operator=(optional_destructor&&) = default;
+    ~optional_destructor() { this->destroy(); }
+};
+
+template <typename T, special_member Kind = special_member_v<
+                          std::is_trivially_copy_constructible<T>::value,
+                          std::is_copy_constructible<T>::value>>
+struct optional_copy_constructor : optional_destructor<T> {
+    using optional_destructor<T>::optional_destructor;
+};
+
+template <typename T>
+struct optional_copy_constructor<T, special_member::provided> : optional_destructor<T> {
+    using optional_destructor<T>::optional_destructor;
+
+    optional_copy_constructor() = default;
+    optional_copy_constructor(const optional_copy_constructor& other) : optional_destructor<T>() {
+        if (other.has_value_) {
+            this->construct(other.storage_.value_);
+        }
+    }
+    optional_copy_constructor(optional_copy_constructor&&) = default;
+    optional_copy_constructor& operator=(const optional_copy_constructor&) = default;
+    optional_copy_constructor& operator=(optional_copy_constructor&&) = default;
+};
+
+template <typename T>
+struct optional_copy_constructor<T, special_member::deleted> : optional_destructor<T> {
+    using optional_destructor<T>::optional_destructor;
+
+    optional_copy_constructor() = default;
+    optional_copy_constructor(const optional_copy_constructor&) = delete;
+    optional_copy_constructor(optional_copy_constructor&&) = default;
+    optional_copy_constructor& operator=(const optional_copy_constructor&) = default;
+    optional_copy_constructor& operator=(optional_copy_constructor&&) = default;
+};
+
+template <typename T, special_member Kind = special_member_v<
+                          std::is_trivially_move_constructible<T>::value,
+                          std::is_move_constructible<T>::value>>
+struct optional_move_constructor : optional_copy_constructor<T> {
+    using optional_copy_constructor<T>::optional_copy_constructor;
+};
+
+template <typename T>
+struct optional_move_constructor<T, special_member::provided> : optional_copy_constructor<T> {
+    using optional_copy_constructor<T>::optional_copy_constructor;
+
+    optional_move_constructor() = default;
+    optional_move_constructor(const optional_move_constructor&) = default;
+    optional_move_constructor(optional_move_constructor&& other) noexcept(
+        std::is_nothrow_move_constructible<T>::value)
+        : optional_copy_constructor<T>() {
+        if (other.has_value_) {
+            this->construct(::learn::move(other.storage_.value_));
+        }
+    }
+    optional_move_constructor& operator=(const optional_move_constructor&) = default;
+    optional_move_constructor& operator=(optional_move_constructor&&) = default;
+};
+
+template <typename T>
+struct optional_move_constructor<T, special_member::deleted> : optional_copy_constructor<T> {
+    using optional_copy_constructor<T>::optional_copy_constructor;
+
+    optional_move_constructor() = default;
+    optional_move_constructor(const optional_move_constructor&) = default;
+    optional_move_constructor(optional_move_constructor&&) = delete;
+    optional_move_constructor& operator=(const optional_move_constructor&) = default;
+    optional_move_constructor& operator=(optional_move_constructor&&) = default;
+};
+
+template <typename T, special_member Kind = special_member_v<
+                          std::is_trivially_copy_constructible<T>::value &&
+                              std::is_trivially_copy_assignable<T>::value &&
+                              std::is_trivially_destructible<T>::value,
+                          std::is_copy_constructible<T>::value &&
+                              std::is_copy_assignable<T>::value>>
+struct optional_copy_assign : optional_move_constructor<T> {
+    using optional_move_constructor<T>::optional_move_constructor;
+};
+
+template <typename T>
+struct optional_copy_assign<T, special_member::provided> : optional_move_constructor<T> {
+    using optional_move_constructor<T>::optional_move_constructor;
+
+    optional_copy_assign() = default;
+    optional_copy_assign(const optional_copy_assign&) = default;
+    optional_copy_assign(optional_copy_assign&&) = default;
+    optional_copy_assign& operator=(const optional_copy_assign& other) {
+        this->assign_from(other);
+        return *this;
+    }
+    optional_copy_assign& operator=(optional_copy_assign&&) = default;
+};
+
+template <typename T>
+struct optional_copy_assign<T, special_member::deleted> : optional_move_constructor<T> {
+    using optional_move_constructor<T>::optional_move_constructor;
+
+    optional_copy_assign() = default;
+    optional_copy_assign(const optional_copy_assign&) = default;
+    optional_copy_assign(optional_copy_assign&&) = default;
+    optional_copy_assign& operator=(const optional_copy_assign&) = delete;
+    optional_copy_assign& operator=(optional_copy_assign&&) = default;
+};
+
+template <typename T, special_member Kind = special_member_v<
+                          std::is_trivially_move_constructible<T>::value &&
+                              std::is_trivially_move_assignable<T>::value &&
+                              std::is_trivially_destructible<T>::value,
+                          std::is_move_constructible<T>::value &&
+                              std::is_move_assignable<T>::value>>
+struct optional_move_assign : optional_copy_assign<T> {
+    using optional_copy_assign<T>::optional_copy_assign;
+};
+
+template <typename T>
+struct optional_move_assign<T, special_member::provided> : optional_copy_assign<T> {
+    using optional_copy_assign<T>::optional_copy_assign;
+
+    optional_move_assign() = default;
+    optional_move_assign(const optional_move_assign&) = default;
+    optional_move_assign(optional_move_assign&&) = default;
+    optional_move_assign& operator=(const optional_move_assign&) = default;
+    optional_move_assign& operator=(optional_move_assign&& other) noexcept(
+        std::is_nothrow_move_constructible<T>::value &&
+        std::is_nothrow_move_assignable<T>::value) {
+        this->assign_from(::learn::move(other));
+        return *this;
+    }
+};
+
+template <typename T>
+struct optional_move_assign<T, special_member::deleted> : optional_copy_assign<T> {
+    using optional_copy_assign<T>::optional_copy_assign;
+
+    optional_move_assign() = default;
+    optional_move_assign(const optional_move_assign&) = default;
+    optional_move_assign(optional_move_assign&&) = default;
+    optional_move_assign& operator=(const optional_move_assign&) = default;
+    optional_move_assign& operator=(optional_move_assign&&) = delete;
+};
 }  // namespace detail
 
+// an optional with a Traits class marks its empty state with a sentinel value of Object, so it is
+// no larger than Object; a Traits class provides
+//   empty_value()         - the sentinel, which never holds a real value
+//   is_empty(value)       - whether value is the sentinel
+// optional<Object> without Traits keeps a separate flag, so every value of Object can be held
+template <typename Object, class Traits = void>
+class optional;
+
+// for floating point values, where NaN is never a valid value
+template <typename T>
+struct nan_sentinel {
+    static_assert(std::numeric_limits<T>::has_quiet_NaN, "nan_sentinel needs a type with NaN");
+
+    static constexpr T empty_value() noexcept { return std::numeric_limits<T>::quiet_NaN(); }
+    static constexpr bool is_empty(const T& value) noexcept { return value != value; }
+};
+
+// for integers, enums and pointers with a spare value, e.g. value_sentinel<int, -1>,
+// value_sentinel<T*, nullptr>, or the largest index for an optional index
+template <typename T, T Sentinel>
+struct value_sentinel {
+    static constexpr T empty_value() noexcept { return Sentinel; }
+    static constexpr bool is_empty(const T& value) noexcept { return value == Sentinel; }
+};
+
 template <typename Object>
-class optional {
+class optional<Object, void> : private detail::optional_move_assign<Object> {
+    using Base = detail::optional_move_assign<Object>;
+
   public:
-    constexpr optional() : has_value_(false) {}
+    using value_type = Object;
 
-    constexpr optional(Object&& object) : has_value_(true), storage_(forward<Object>(object)) {}
+    constexpr optional() = default;
 
-    constexpr optional(const Object& object) : has_value_(true), storage_(object) {}
+    constexpr optional(Object&& object) : Base(in_place, ::learn::move(object)) {}
 
-    constexpr optional& operator=(const Object& object) {
-        has_value_ = true;
-        storage_ = object;
+    constexpr optional(const Object& object) : Base(in_place, object) {}
+
+    template <typename... Args>
+    constexpr explicit optional(in_place_t, Args&&... args)
+        : Base(in_place, ::learn::forward<Args>(args)...) {}
+
+    optional& operator=(const Object& object) {
+        assign(object);
         return *this;
     }
 
-    constexpr bool has_value() const noexcept { return has_value_; }
-    constexpr explicit operator bool() const noexcept { return has_value_; }
+    optional& operator=(Object&& object) {
+        assign(::learn::move(object));
+        return *this;
+    }
+
+    constexpr bool has_value() const noexcept { return this->has_value_; }
+    constexpr explicit operator bool() const noexcept { return this->has_value_; }
 
     constexpr Object& value() {
-        if (!has_value_) {
+        if (!this->has_value_) {
             throw std::bad_cast();
         }
-        return storage_.value_;
+        return this->storage_.value_;
     }
 
     constexpr const Object& value() const {
-        if (!has_value_) {
+        if (!this->has_value_) {
             throw std::bad_cast();
         }
-        return storage_.value_;
+        return this->storage_.value_;
     }
 
+    // unchecked access
+    constexpr Object& operator*() noexcept { return this->storage_.value_; }
+    constexpr const Object& operator*() const noexcept { return this->storage_.value_; }
+    constexpr Object* operator->() noexcept { return &this->storage_.value_; }
+    constexpr const Object* operator->() const noexcept { return &this->storage_.value_; }
+
     template <typename AltObject>
     constexpr Object value_or(AltObject&& default_value) const {
-        if (!has_value_) {
-            return default_value;
+        if (!this->has_value_) {
+            return static_cast<Object>(::learn::forward<AltObject>(default_value));
+        }
+
+        return this->storage_.value_;
+    }
+
+    void swap(optional& other) {
+        if (this->has_value_ && other.has_value_) {
+            ::learn::swap(**this, *other);
+        } else if (this->has_value_) {
+            other.construct(::learn::move(**this));
+            this->destroy();
+        } else if (other.has_value_) {
+            this->construct(::learn::move(*other));
+            other.destroy();
+        }
+    }
+
+    void reset() noexcept { this->destroy(); }
+
+    // constructs the object directly in the storage, so Object needn't be movable
+    template <typename... Args>
+    Object& emplace(Args&&... args) {
+        reset();
+        this->construct(::learn::forward<Args>(args)...);
+        return this->storage_.value_;
+    }
+
+  private:
+    template <typename Value>
+    void assign(Value&& value) {
+        if (this->has_value_) {
+            this->storage_.value_ = ::learn::forward<Value>(value);
+        } else {
+            this->construct(::learn::forward<Value>(value));
         }
+    }
+};
+
+// value_ always holds an Object, the sentinel when empty, so the special members are Object's own
+template <typename Object, class Traits>
+class optional {
+  public:
+    using value_type = Object;
+    using traits_type = Traits;
+
+    constexpr optional() noexcept(std::is_nothrow_move_constructible<Object>::value)
+        : value_(Traits::empty_value()) {}
+
+    // holding the sentinel leaves the optional empty
+    constexpr optional(Object&& object) : value_(::learn::move(object)) {}
+
+    constexpr optional(const Object& object) : value_(object) {}
 
-        value();
+    template <typename... Args>
+    constexpr explicit optional(in_place_t, Args&&... args)
+        : value_(::learn::forward<Args>(args)...) {}
+
+    optional& operator=(const Object& object) {
+        value_ = object;
+        return *this;
     }
 
-    constexpr void swap(optional& other) noexcept {
-        if (!has_value_ && !other.has_value_) {
-            return;
+    optional& operator=(Object&& object) {
+        value_ = ::learn::move(object);
+        return *this;
+    }
+
+    constexpr bool has_value() const noexcept { return !Traits::is_empty(value_); }
+    constexpr explicit operator bool() const noexcept { return has_value(); }
+
+    constexpr Object& value() {
+        if (!has_value()) {
+            throw std::bad_cast();
         }
+        return value_;
+    }
 
-        if (has_value_ && !other.has_value) {
-            other = move(**this);
-            this->operator~();
+    constexpr const Object& value() const {
+        if (!has_value()) {
+            throw std::bad_cast();
         }
+        return value_;
+    }
 
-        if (!has_value_ && other.has_value) {
-            **this = move(other);
-            other->operator~();
+    constexpr Object& operator*() noexcept { return value_; }
+    constexpr const Object& operator*() const noexcept { return value_; }
+    constexpr Object* operator->() noexcept { return &value_; }
+    constexpr const Object* operator->() const noexcept { return &value_; }
+
+    template <typename AltObject>
+    constexpr Object value_or(AltObject&& default_value) const {
+        if (!has_value()) {
+            return static_cast<Object>(::learn::forward<AltObject>(default_value));
         }
 
-        ::learn::swap(**this, *other);
+        return value_;
     }
 
-    constexpr void reset() noexcept { has_value_ = false; }
+    void swap(optional& other) { ::learn::swap(value_, other.value_); }
+
+    void reset() { value_ = Traits::empty_value(); }
 
+    // value_ must always hold an Object, so one which might throw is built aside and moved in
     template <typename... Args>
-    constexpr Object& emplace(Args&&... args) {
-        has_value_ = true;
-        storage_ = move(Object(args...));
-        return storage_.value_;
+    Object& emplace(Args&&... args) {
+        if constexpr (std::is_nothrow_constructible<Object, Args&&...>::value) {
+            value_.~Object();
+            ::new (static_cast<void*>(&value_)) Object(::learn::forward<Args>(args)...);
+        } else {
+            value_ = Object(::learn::forward<Args>(args)...);
+        }
+        return value_;
     }
 
   private:
-    using Storage = detail::optional_storage<Object>;
-    bool has_value_;
-    Storage storage_;
+    Object value_;
 };
 
-}  // namespace learn
\ No newline at end of file
+template <typename Object, class Traits>
+void swap(optional<Object, Traits>& lhs, optional<Object, Traits>& rhs) {
+    lhs.swap(rhs);
+}
+
+}  // namespace learn
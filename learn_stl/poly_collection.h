@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+
+#include <type_traits>
+
+#include "tuple.h"
+#include "utility.h"
+#include "vector.h"
+
+namespace learn {
+namespace detail {
+template <typename Object, typename... Types>
+constexpr std::size_t segment_index() {
+    constexpr bool matches[] = {std::is_same<Object, Types>::value...};
+
+    for (std::size_t i = 0; i < sizeof...(Types); ++i) {
+        if (matches[i]) {
+            return i;
+        }
+    }
+
+    return sizeof...(Types);
+}
+}  // namespace detail
+
+// a heterogeneous collection that keeps each type's elements together in their own vector, so
+// iterating is a plain loop over contiguous memory per type rather than a pointer chase per
+// element; elements keep their insertion order within a type but not across types
+template <typename... Types>
+class poly_collection {
+    static_assert(sizeof...(Types) > 0, "a poly_collection needs at least one type");
+    static_assert((std::is_same<Types, std::decay_t<Types>>::value && ...),
+                  "poly_collection types must not be references or cv-qualified");
+
+    template <typename Object>
+    static constexpr std::size_t index_of = detail::segment_index<Object, Types...>();
+
+    template <typename Object>
+    static constexpr bool contains = index_of<Object> < sizeof...(Types);
+
+  public:
+    using size_type = std::size_t;
+
+    template <typename Object>
+    using segment_type = vector<Object>;
+
+    poly_collection() : segments_(segment_type<Types>()...) {}
+
+    // element access
+
+    template <typename Object>
+    segment_type<Object>& segment() noexcept {
+        static_assert(contains<Object>, "type is not stored in this poly_collection");
+        return get<index_of<Object>>(segments_);
+    }
+
+    template <typename Object>
+    const segment_type<Object>& segment() const noexcept {
+        static_assert(contains<Object>, "type is not stored in this poly_collection");
+        return get<index_of<Object>>(segments_);
+    }
+
+    // capacity
+
+    size_type size() const noexcept { return (segment<Types>().size() + ...); }
+
+    template <typename Object>
+    size_type size() const noexcept {
+        return segment<Object>().size();
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    template <typename Object>
+    void reserve(size_type new_capacity) {
+        segment<Object>().reserve(new_capacity);
+    }
+
+    // modifiers
+
+    template <typename Object>
+    std::decay_t<Object>& insert(Object&& object) {
+        return segment<std::decay_t<Object>>().emplace_back(::learn::forward<Object>(object));
+    }
+
+    template <typename Object, typename... Args>
+    Object& emplace(Args&&... args) {
+        return segment<Object>().emplace_back(::learn::forward<Args>(args)...);
+    }
+
+    void clear() { (segment<Types>().clear(), ...); }
+
+    // iteration, fn is called with each element as its concrete type; the loop for each type is
+    // a separate instantiation, so there's no dispatch inside it
+
+    template <typename Fn>
+    Fn for_each(Fn fn) {
+        (for_each_in(segment<Types>(), fn), ...);
+        return fn;
+    }
+
+    template <typename Fn>
+    Fn for_each(Fn fn) const {
+        (for_each_in(segment<Types>(), fn), ...);
+        return fn;
+    }
+
+    // fn is called once per type with the whole segment, for loops that want the vector itself
+    template <typename Fn>
+    Fn for_each_segment(Fn fn) {
+        (fn(segment<Types>()), ...);
+        return fn;
+    }
+
+    template <typename Fn>
+    Fn for_each_segment(Fn fn) const {
+        (fn(segment<Types>()), ...);
+        return fn;
+    }
+
+  private:
+    tuple<segment_type<Types>...> segments_;
+
+    template <class Segment, typename Fn>
+    static void for_each_in(Segment& segment, Fn& fn) {
+        for (auto& element : segment) {
+            fn(element);
+        }
+    }
+};
+
+}  // namespace learn
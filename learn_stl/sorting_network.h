@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdlib>
+
+#include <functional>
+#include <type_traits>
+
+#include "algorithm.h"
+#include "array.h"
+#include "utility.h"
+
+namespace learn {
+namespace detail {
+struct comparator {
+    std::size_t low;
+    std::size_t high;
+};
+
+// Batcher's odd-even merge sort, generated for a power of two and pruned to the comparators
+// within [0, n); calls fn(low, high) for each comparator, one layer after another, so the
+// comparators of a layer are independent of each other
+template <class Fn>
+constexpr void batcher_network(std::size_t n, Fn fn) {
+    for (std::size_t p = 1; p < n; p *= 2) {
+        for (std::size_t k = p; k >= 1; k /= 2) {
+            for (std::size_t j = k % p; j + k < n; j += 2 * k) {
+                for (std::size_t i = 0; i < k && i + j + k < n; ++i) {
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                        fn(i + j, i + j + k);
+                    }
+                }
+            }
+        }
+    }
+}
+
+constexpr std::size_t batcher_network_size(std::size_t n) {
+    std::size_t count = 0;
+    batcher_network(n, [&count](std::size_t, std::size_t) { ++count; });
+
+    return count;
+}
+
+template <std::size_t Size>
+constexpr array<comparator, Size> make_batcher_network(std::size_t n) {
+    array<comparator, Size> result{};
+    std::size_t count = 0;
+    batcher_network(n, [&](std::size_t low, std::size_t high) {
+        result[count++] = comparator{low, high};
+    });
+
+    return result;
+}
+}  // namespace detail
+
+// the comparators that sort N elements, generated at compile time
+template <std::size_t N>
+struct sorting_network {
+    static constexpr std::size_t size = detail::batcher_network_size(N);
+    static constexpr array<detail::comparator, size> comparators =
+        detail::make_batcher_network<size>(N);
+};
+
+namespace detail {
+// puts the smaller of low and high in low; arithmetic values are always written back, which
+// compiles to min and max rather than a branch
+template <typename T, class Compare>
+constexpr void compare_exchange(T& low, T& high, Compare& comp) {
+    if constexpr (std::is_arithmetic<T>::value) {
+        const bool out_of_order = comp(high, low);
+        const T smaller = out_of_order ? high : low;
+        const T larger = out_of_order ? low : high;
+
+        low = smaller;
+        high = larger;
+    } else if (comp(high, low)) {
+        ::learn::swap(low, high);
+    }
+}
+
+template <typename T, std::size_t N, class Compare, std::size_t... Indices>
+constexpr void apply_network(array<T, N>& values, Compare& comp, index_sequence<Indices...>) {
+    using Network = sorting_network<N>;
+    (compare_exchange(values[Network::comparators[Indices].low],
+                      values[Network::comparators[Indices].high], comp),
+     ...);
+}
+}  // namespace detail
+
+// sorts a small array with a fixed sequence of compare-exchanges rather than data dependent
+// branches, which suits arrays of up to 32 or so elements; usable in constant expressions
+template <typename T, std::size_t N, class Compare>
+constexpr void sort(array<T, N>& values, Compare comp) {
+    using Sequence = make_index_sequence<sorting_network<N>::size>;
+    detail::apply_network(values, comp, typename Sequence::type());
+}
+
+template <typename T, std::size_t N>
+constexpr void sort(array<T, N>& values) {
+    ::learn::sort(values, std::less<T>());
+}
+
+}  // namespace learn
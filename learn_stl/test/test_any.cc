@@ -3,7 +3,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "helpers.h"
+#include "learn_stl/array.h"
 
 TEST(Any, emptyConstruction) {
     using learn::any;
@@ -84,6 +87,18 @@ TYPED_TEST(AnyTest, type) {
     EXPECT_EQ(value.type(), typeid(TypeParam));
 }
 
+TYPED_TEST(AnyTest, typeId) {
+    using learn::any;
+    using learn::detail::type_id;
+
+    any value;
+    EXPECT_EQ(value.type_id(), type_id<void>());
+
+    value.emplace<TypeParam>(helpers::generate<TypeParam>());
+    EXPECT_EQ(value.type_id(), type_id<TypeParam>());
+    EXPECT_NE(value.type_id(), type_id<char>());
+}
+
 TYPED_TEST(AnyTest, AnyCastPtr) {
     using learn::any;
     using learn::any_cast;
@@ -210,4 +225,198 @@ TYPED_TEST(AnyTest, MoveConstruction) {
     ASSERT_FALSE(value.has_value());
 
     ASSERT_EQ(learn::any_cast<TypeParam>(new_value), helpers::generate<TypeParam>());
-}
\ No newline at end of file
+}
+
+TEST(Any, FitsInline) {
+    using learn::detail::any_fits_inline;
+
+    struct Large {
+        double values[8];
+    };
+
+    struct ThrowingMove {
+        ThrowingMove() = default;
+        ThrowingMove(ThrowingMove&&) noexcept(false) {}
+    };
+
+    static_assert(any_fits_inline<int>);
+    static_assert(any_fits_inline<void*>);
+    static_assert(any_fits_inline<learn::array<double, 3>>);
+    static_assert(!any_fits_inline<Large>);
+    static_assert(!any_fits_inline<ThrowingMove>);
+
+    // the default allocator is empty, so it costs nothing as a base class
+    static_assert(sizeof(learn::any) == 4 * sizeof(void*));
+}
+
+namespace {
+struct Counted {
+    static int num_alive;
+
+    explicit Counted(int v) : value(v) { num_alive += 1; }
+    Counted(const Counted& other) : value(other.value) { num_alive += 1; }
+    Counted(Counted&& other) noexcept : value(other.value) { num_alive += 1; }
+    ~Counted() { num_alive -= 1; }
+
+    int value;
+};
+
+int Counted::num_alive = 0;
+
+struct LargeCounted : Counted {
+    using Counted::Counted;
+    double padding[8] = {};
+};
+}  // namespace
+
+template <typename TypeT>
+class AnyLifetimeTest : public ::testing::Test {};
+
+using LifetimeTypes = testing::Types<Counted, LargeCounted>;
+TYPED_TEST_SUITE(AnyLifetimeTest, LifetimeTypes);
+
+TYPED_TEST(AnyLifetimeTest, CopyMoveDestroy) {
+    using learn::any;
+    using learn::any_cast;
+
+    {
+        any value = TypeParam(3);
+        EXPECT_EQ(Counted::num_alive, 1);
+
+        any copy = value;
+        EXPECT_EQ(Counted::num_alive, 2);
+        EXPECT_EQ(any_cast<TypeParam>(&copy)->value, 3);
+
+        any moved = learn::move(value);
+        EXPECT_FALSE(value.has_value());
+        EXPECT_EQ(Counted::num_alive, 2);
+        EXPECT_EQ(any_cast<TypeParam>(&moved)->value, 3);
+
+        any other = 2.0;
+        learn::swap(other, moved);
+        EXPECT_EQ(any_cast<TypeParam>(&other)->value, 3);
+        EXPECT_EQ(any_cast<double>(moved), 2.0);
+
+        other.emplace<TypeParam>(5);
+        EXPECT_EQ(Counted::num_alive, 2);
+        EXPECT_EQ(any_cast<TypeParam>(&other)->value, 5);
+    }
+
+    EXPECT_EQ(Counted::num_alive, 0);
+}
+
+TEST(UniqueAny, MoveOnly) {
+    using learn::any_cast;
+    using learn::unique_any;
+
+    static_assert(!std::is_copy_constructible<unique_any>::value);
+
+    unique_any value = learn::make_unique<int>(3);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(**any_cast<learn::unique_ptr<int>>(&value), 3);
+
+    unique_any moved = learn::move(value);
+    EXPECT_FALSE(value.has_value());
+
+    auto ptr = any_cast<learn::unique_ptr<int>>(learn::move(moved));
+    EXPECT_EQ(*ptr, 3);
+}
+
+TEST(UniqueAny, Emplace) {
+    using learn::any_cast;
+    using learn::unique_any;
+
+    unique_any value;
+    auto& ptr = value.emplace<learn::unique_ptr<double>>(new double(2.5));
+
+    EXPECT_EQ(*ptr, 2.5);
+    EXPECT_EQ(any_cast<learn::unique_ptr<double>>(&value), &ptr);
+    EXPECT_EQ(any_cast<int>(&value), nullptr);
+}
+
+TEST(Any, StandardLibraryTypes) {
+    using learn::any;
+    using learn::any_cast;
+
+    // argument dependent lookup also finds std::forward for these
+    any value = std::string("first");
+    EXPECT_EQ(any_cast<std::string>(value), "first");
+
+    value = std::string(64, 'x');
+    EXPECT_EQ(any_cast<std::string>(value), std::string(64, 'x'));
+
+    value.emplace<std::string>(std::string("second"));
+    EXPECT_EQ(any_cast<std::string>(value), "second");
+}
+
+namespace {
+struct AllocatorStats {
+    int num_allocations = 0;
+    int num_deallocations = 0;
+};
+
+template <class T>
+struct CountingAllocator {
+    using value_type = T;
+
+    explicit CountingAllocator(AllocatorStats* stats) noexcept : stats(stats) {}
+
+    template <class U>
+    CountingAllocator(const CountingAllocator<U>& other) noexcept : stats(other.stats) {}
+
+    T* allocate(std::size_t n) {
+        stats->num_allocations += 1;
+        return learn::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        stats->num_deallocations += 1;
+        learn::allocator<T>().deallocate(p, n);
+    }
+
+    AllocatorStats* stats;
+};
+
+struct Large {
+    double values[8];
+};
+}  // namespace
+
+TEST(AllocatorAny, HeapObjectsUseAllocator) {
+    using Any = learn::basic_any<CountingAllocator<unsigned char>>;
+    using learn::any_cast;
+
+    AllocatorStats stats;
+
+    {
+        Any value(std::allocator_arg, CountingAllocator<unsigned char>(&stats), Large{{1.0}});
+        EXPECT_EQ(stats.num_allocations, 1);
+
+        Any copy = value;
+        EXPECT_EQ(stats.num_allocations, 2);
+        EXPECT_EQ(any_cast<Large>(&copy)->values[0], 1.0);
+
+        Any moved = learn::move(value);
+        EXPECT_EQ(stats.num_allocations, 2);
+
+        moved = Large{{2.0}};
+        EXPECT_EQ(stats.num_allocations, 3);
+        EXPECT_EQ(stats.num_deallocations, 1);
+    }
+
+    EXPECT_EQ(stats.num_deallocations, 3);
+}
+
+TEST(AllocatorAny, InlineObjectsDontAllocate) {
+    using Any = learn::basic_unique_any<CountingAllocator<unsigned char>>;
+    using learn::any_cast;
+
+    AllocatorStats stats;
+
+    Any value{CountingAllocator<unsigned char>(&stats)};
+    value.emplace<int>(3);
+    value = learn::move(Any(std::allocator_arg, CountingAllocator<unsigned char>(&stats), 4.0));
+
+    EXPECT_EQ(any_cast<double>(value), 4.0);
+    EXPECT_EQ(stats.num_allocations, 0);
+}
@@ -0,0 +1,160 @@
+#include "learn_stl/array_math.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "helpers.h"
+#include "learn_stl/valarray.h"
+
+// a register is never wider than the target's
+static_assert(learn::detail::simd_lanes<float, 3>() == 4, "");
+static_assert(learn::detail::simd_lanes<double, 16>() * sizeof(double) <=
+                  learn::detail::simd_register_bytes,
+              "");
+static_assert(learn::detail::simd_lanes<int, 5>() == 0, "");
+static_assert(learn::detail::simd_lanes<bool, 4>() == 0, "");
+
+namespace {
+template <typename T, std::size_t N>
+learn::array<T, N> iota(T first) {
+    learn::array<T, N> result;
+    for (std::size_t i = 0; i < N; ++i) {
+        result[i] = first + static_cast<T>(i);
+    }
+
+    return result;
+}
+
+// checks each operator against a plain loop, for sizes with and without a SIMD form
+template <typename T, std::size_t N>
+void check_elementwise() {
+    const auto a = iota<T, N>(T(1));
+    const auto b = iota<T, N>(T(3));
+
+    const auto sum = a + b;
+    const auto difference = b - a;
+    const auto product = a * b;
+    const auto quotient = b / a;
+    const auto scaled = a * T(2);
+    const auto shifted = a + T(1);
+    const auto negated = -a;
+    const auto smaller = learn::min(a, b);
+    const auto larger = learn::max(a, b);
+
+    T expected_dot = T(0);
+    for (std::size_t i = 0; i < N; ++i) {
+        EXPECT_EQ(sum[i], a[i] + b[i]);
+        EXPECT_EQ(difference[i], b[i] - a[i]);
+        EXPECT_EQ(product[i], a[i] * b[i]);
+        EXPECT_EQ(quotient[i], b[i] / a[i]);
+        EXPECT_EQ(scaled[i], a[i] * T(2));
+        EXPECT_EQ(shifted[i], a[i] + T(1));
+        EXPECT_EQ(negated[i], -a[i]);
+        EXPECT_EQ(smaller[i], a[i]);
+        EXPECT_EQ(larger[i], b[i]);
+
+        expected_dot += a[i] * b[i];
+    }
+
+    EXPECT_EQ(learn::dot(a, b), expected_dot);
+}
+}  // namespace
+
+TEST(ArrayMath, elementwiseDouble) {
+    check_elementwise<double, 2>();
+    check_elementwise<double, 3>();
+    check_elementwise<double, 4>();
+    check_elementwise<double, 5>();
+    check_elementwise<double, 8>();
+    check_elementwise<double, 16>();
+}
+
+TEST(ArrayMath, elementwiseFloat) {
+    check_elementwise<float, 3>();
+    check_elementwise<float, 4>();
+    check_elementwise<float, 16>();
+}
+
+TEST(ArrayMath, elementwiseInt) {
+    // the padded lane of a 3 element division holds 1 rather than 0
+    check_elementwise<int, 3>();
+    check_elementwise<int, 4>();
+    check_elementwise<int, 7>();
+    check_elementwise<int, 8>();
+}
+
+TEST(ArrayMath, negateFlipsSign) {
+    const double nan = std::nan("");
+    const learn::array<double, 3> values = {0.0, -0.0, nan};
+    const auto negated = -values;
+
+    EXPECT_TRUE(std::signbit(negated[0]));
+    EXPECT_FALSE(std::signbit(negated[1]));
+    EXPECT_TRUE(std::isnan(negated[2]));
+    EXPECT_NE(std::signbit(negated[2]), std::signbit(nan));
+
+    // and without a SIMD form
+    const learn::array<float, 5> plain = {0.0f, -0.0f, 1.0f, -1.0f, 0.0f};
+    const auto plain_negated = -plain;
+    for (std::size_t i = 0; i < plain.size(); ++i) {
+        EXPECT_NE(std::signbit(plain_negated[i]), std::signbit(plain[i]));
+    }
+}
+
+TEST(ArrayMath, compoundAssignment) {
+    learn::array<double, 3> values = {1.0, 2.0, 3.0};
+
+    values += learn::array<double, 3>{1.0, 1.0, 1.0};
+    values *= 2;
+    values -= 1.0;
+    values /= learn::array<double, 3>{1.0, 5.0, 7.0};
+
+    EXPECT_THAT(values, testing::ElementsAre(3.0, 1.0, 1.0));
+}
+
+TEST(ArrayMath, crossAndNorm) {
+    const learn::array<double, 3> x = {1.0, 0.0, 0.0};
+    const learn::array<double, 3> y = {0.0, 1.0, 0.0};
+
+    EXPECT_THAT(learn::cross(x, y), testing::ElementsAre(0.0, 0.0, 1.0));
+    EXPECT_THAT(learn::cross(y, x), testing::ElementsAre(0.0, 0.0, -1.0));
+
+    const auto value = helpers::generate<learn::array<double, 3>>();
+    EXPECT_NEAR(learn::dot(learn::cross(value, x), value), 0.0, 1e-12);
+    EXPECT_DOUBLE_EQ(learn::norm(value), std::sqrt(value[0] * value[0] + value[1] * value[1] +
+                                                   value[2] * value[2]));
+
+    EXPECT_DOUBLE_EQ(learn::norm(learn::array<int, 2>{3, 4}), 5.0);
+}
+
+TEST(ArrayMath, batched) {
+    using Point = learn::array<double, 3>;
+
+    learn::vector<Point> points;
+    learn::vector<Point> offsets;
+    for (int i = 0; i < 10; ++i) {
+        points.emplace_back(Point{double(i), 0.0, 1.0});
+        offsets.emplace_back(Point{1.0, double(i), 0.0});
+    }
+
+    learn::batch_add(points, offsets);
+    learn::batch_scale(points, 2.0);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(helpers::equal(points[i], Point{2.0 * (i + 1), 2.0 * i, 2.0}));
+    }
+
+    learn::batch_subtract(points, points);
+    EXPECT_EQ(learn::batch_norm(points)[4], 0.0);
+
+    const auto dots = learn::batch_dot(offsets, offsets);
+    ASSERT_EQ(dots.size(), 10u);
+    EXPECT_EQ(dots[3], 10.0);
+
+    learn::batch_multiply(offsets, offsets);
+    EXPECT_THAT(offsets[3], testing::ElementsAre(1.0, 9.0, 0.0));
+
+    learn::vector<Point> shorter;
+    EXPECT_THROW(learn::batch_add(points, shorter), std::invalid_argument);
+}
@@ -0,0 +1,152 @@
+#include "learn_stl/epoch.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "learn_stl/memory.h"
+#include "learn_stl/vector.h"
+
+namespace {
+std::atomic<int> num_deleted{0};
+
+struct counting_delete {
+    void operator()(int* ptr) const noexcept {
+        num_deleted += 1;
+        delete ptr;
+    }
+};
+
+struct counting_array_delete {
+    void operator()(int* ptr) const noexcept {
+        num_deleted += 1;
+        delete[] ptr;
+    }
+};
+}  // namespace
+
+TEST(Epoch, PinnedGuardBlocksReclaim) {
+    learn::epoch_domain domain;
+    num_deleted = 0;
+    constexpr int num_objects = 3 * learn::epoch_domain::reclaim_batch_size;
+
+    {
+        auto reader = domain.pin();
+        auto writer = domain.pin();
+
+        for (int i = 0; i < num_objects; ++i) {
+            writer.retire<int, counting_delete>(new int(i));
+        }
+
+        writer.reclaim();
+        EXPECT_EQ(num_deleted, 0);
+    }
+
+    for (int i = 0; i < 4 && num_deleted < num_objects; ++i) {
+        domain.pin().reclaim();
+    }
+
+    EXPECT_EQ(num_deleted, num_objects);
+}
+
+TEST(Epoch, DomainDestructorReclaims) {
+    num_deleted = 0;
+
+    {
+        learn::epoch_domain domain;
+        auto guard = domain.pin();
+        guard.retire<int, counting_delete>(new int(3));
+        guard.retire<int, counting_delete>(new int(4));
+    }
+
+    EXPECT_EQ(num_deleted, 2);
+}
+
+TEST(Epoch, RetireUniquePtr) {
+    num_deleted = 0;
+
+    {
+        learn::epoch_domain domain;
+        auto ptr = learn::unique_ptr<int, counting_delete>(new int(3));
+
+        domain.pin().retire(learn::move(ptr));
+        EXPECT_FALSE(ptr);
+
+        auto array = learn::unique_ptr<int[], counting_array_delete>(new int[4]());
+        domain.pin().retire(learn::move(array));
+        EXPECT_FALSE(array);
+
+        domain.pin().retire(learn::make_unique<int[]>(8));
+    }
+
+    EXPECT_EQ(num_deleted, 2);
+}
+
+TEST(Epoch, EpochAdvances) {
+    learn::epoch_domain domain;
+    const auto start = domain.epoch();
+
+    for (int i = 0; i < 4; ++i) {
+        domain.pin().reclaim();
+    }
+
+    EXPECT_GT(domain.epoch(), start);
+}
+
+// readers check a snapshot is never torn or freed while writers swap it; run with WITH_TSAN
+TEST(Epoch, SnapshotStress) {
+    using Snapshot = learn::vector<int>;
+    constexpr int num_readers = 4;
+    constexpr int num_writers = 2;
+    constexpr int num_writes = 2000;
+    constexpr int snapshot_size = 64;
+
+    learn::epoch_domain domain;
+    std::atomic<Snapshot*> snapshot{new Snapshot(snapshot_size, 0)};
+    std::atomic<bool> done{false};
+    std::atomic<int> num_bad{0};
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < num_readers; ++r) {
+        threads.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire)) {
+                auto guard = domain.pin();
+                const Snapshot* values = snapshot.load(std::memory_order_acquire);
+
+                const int first = values->front();
+                for (const int value : *values) {
+                    if (value != first) {
+                        num_bad += 1;
+                    }
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < num_writers; ++w) {
+        writers.emplace_back([&, w] {
+            for (int i = 0; i < num_writes; ++i) {
+                auto* next = new Snapshot(snapshot_size, w * num_writes + i);
+                auto* prev = snapshot.exchange(next, std::memory_order_acq_rel);
+
+                domain.pin().retire(prev);
+            }
+        });
+    }
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    done = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(num_bad, 0);
+    delete snapshot.load();
+}
@@ -0,0 +1,241 @@
+#include "learn_stl/functional.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "learn_stl/algorithm.h"
+#include "learn_stl/array.h"
+#include "learn_stl/memory.h"
+#include "learn_stl/vector.h"
+
+namespace {
+int add_one(int value) { return value + 1; }
+
+struct Counter {
+    static inline int alive = 0;
+
+    Counter() { ++alive; }
+    Counter(const Counter&) { ++alive; }
+    Counter(Counter&&) noexcept { ++alive; }
+    ~Counter() { --alive; }
+
+    int operator()(int value) const { return value; }
+};
+
+struct Large {
+    learn::array<long, 8> payload{};
+
+    long operator()(int value) const { return payload[0] + value; }
+};
+}  // namespace
+
+TEST(Function, emptyConstruction) {
+    learn::function<int(int)> fn;
+    ASSERT_FALSE(fn);
+    ASSERT_THROW(fn(1), std::bad_function_call);
+
+    learn::function<int(int)> null_fn = nullptr;
+    ASSERT_FALSE(null_fn);
+
+    int (*null_ptr)(int) = nullptr;
+    learn::function<int(int)> from_null_ptr = null_ptr;
+    ASSERT_FALSE(from_null_ptr);
+}
+
+TEST(Function, call) {
+    learn::function<int(int)> from_pointer = add_one;
+    ASSERT_EQ(from_pointer(1), 2);
+
+    const int offset = 10;
+    learn::function<int(int)> from_lambda = [offset](int value) { return value + offset; };
+    ASSERT_EQ(from_lambda(1), 11);
+
+    learn::function<long(int)> from_large = Large{{5}};
+    ASSERT_EQ(from_large(1), 6);
+}
+
+TEST(Function, memberPointer) {
+    struct Point {
+        int x;
+        int get() const { return x; }
+    };
+
+    learn::function<int(const Point&)> get = &Point::get;
+    learn::function<int(const Point&)> x = &Point::x;
+
+    ASSERT_EQ(get(Point{3}), 3);
+    ASSERT_EQ(x(Point{4}), 4);
+}
+
+TEST(Function, mutableState) {
+    int calls = 0;
+    learn::function<void()> fn = [&calls]() { ++calls; };
+
+    fn();
+    fn();
+    ASSERT_EQ(calls, 2);
+
+    learn::function<int()> counter = [count = 0]() mutable { return ++count; };
+    ASSERT_EQ(counter(), 1);
+    ASSERT_EQ(counter(), 2);
+}
+
+TEST(Function, copyAndMove) {
+    learn::function<long(int)> small = [](int value) { return long{value}; };
+    learn::function<long(int)> large = Large{{100}};
+
+    auto small_copy = small;
+    auto large_copy = large;
+    ASSERT_EQ(small_copy(1), 1);
+    ASSERT_EQ(large_copy(1), 101);
+    ASSERT_EQ(large(1), 101);
+
+    auto moved = learn::move(large_copy);
+    ASSERT_FALSE(large_copy);
+    ASSERT_EQ(moved(2), 102);
+
+    small = moved;
+    ASSERT_EQ(small(3), 103);
+
+    small = nullptr;
+    ASSERT_FALSE(small);
+}
+
+TEST(Function, swap) {
+    learn::function<long(int)> small = [](int value) { return long{value}; };
+    learn::function<long(int)> large = Large{{100}};
+
+    swap(small, large);
+    ASSERT_EQ(small(1), 101);
+    ASSERT_EQ(large(1), 1);
+
+    small.swap(small);
+    ASSERT_EQ(small(1), 101);
+}
+
+TEST(Function, lifetime) {
+    Counter::alive = 0;
+
+    {
+        learn::function<int(int)> fn = Counter{};
+        ASSERT_EQ(Counter::alive, 1);
+
+        auto copy = fn;
+        ASSERT_EQ(Counter::alive, 2);
+
+        auto moved = learn::move(copy);
+        ASSERT_EQ(Counter::alive, 2);
+
+        fn = [](int value) { return value; };
+        ASSERT_EQ(Counter::alive, 1);
+    }
+
+    ASSERT_EQ(Counter::alive, 0);
+}
+
+TEST(Function, moveOnlyResult) {
+    learn::function<learn::unique_ptr<int>()> make = []() { return learn::make_unique<int>(7); };
+    ASSERT_EQ(*make(), 7);
+}
+
+TEST(Function, voidDiscardsResult) {
+    int calls = 0;
+    const auto count = [&calls](int value) { return calls += value; };
+
+    learn::function<void(int)> fn = count;
+    fn(1);
+
+    learn::inplace_function<void(int)> inplace = count;
+    inplace(2);
+
+    learn::function_ref<void(int)> ref = count;
+    ref(3);
+
+    ASSERT_EQ(calls, 6);
+}
+
+TEST(Function, standardLibraryArguments) {
+    // argument dependent lookup also finds std::forward for these
+    const auto length = [](std::string value) { return value.size(); };
+
+    learn::function<std::size_t(std::string)> fn = length;
+    ASSERT_EQ(fn(std::string("abc")), 3u);
+
+    learn::function_ref<std::size_t(std::string)> ref = length;
+    ASSERT_EQ(ref(std::string("abcd")), 4u);
+}
+
+TEST(InplaceFunction, call) {
+    const long offset = 3;
+    learn::inplace_function<long(int)> fn = [offset](int value) { return value + offset; };
+    ASSERT_EQ(fn(1), 4);
+
+    learn::inplace_function<long(int), sizeof(Large)> large = Large{{5}};
+    ASSERT_EQ(large(1), 6);
+
+    auto copy = large;
+    ASSERT_EQ(copy(2), 7);
+
+    large = nullptr;
+    ASSERT_FALSE(large);
+    ASSERT_THROW(large(1), std::bad_function_call);
+}
+
+TEST(InplaceFunction, fitsInline) {
+    using learn::detail::function_fits_inline;
+
+    static_assert(function_fits_inline<Large, sizeof(Large), alignof(void*)>);
+    static_assert(!function_fits_inline<Large, sizeof(Large) - 1, alignof(void*)>);
+    static_assert(sizeof(learn::inplace_function<void(), 64>) == 64 + 2 * sizeof(void*));
+}
+
+TEST(InplaceFunction, lifetime) {
+    Counter::alive = 0;
+
+    {
+        learn::inplace_function<int(int)> fn = Counter{};
+        auto copy = fn;
+        ASSERT_EQ(Counter::alive, 2);
+
+        swap(fn, copy);
+        ASSERT_EQ(Counter::alive, 2);
+    }
+
+    ASSERT_EQ(Counter::alive, 0);
+}
+
+TEST(FunctionRef, call) {
+    learn::function_ref<int(int)> from_function = add_one;
+    ASSERT_EQ(from_function(1), 2);
+
+    int offset = 10;
+    auto lambda = [&offset](int value) { return value + offset; };
+    learn::function_ref<int(int)> from_lambda = lambda;
+    ASSERT_EQ(from_lambda(1), 11);
+
+    // a reference, so it sees later changes to the callable's state
+    offset = 20;
+    ASSERT_EQ(from_lambda(1), 21);
+
+    auto copy = from_lambda;
+    ASSERT_EQ(copy(2), 22);
+}
+
+TEST(FunctionRef, algorithm) {
+    learn::vector<int> values;
+    for (int i = 0; i < 10; ++i) {
+        values.emplace_back(i);
+    }
+
+    const auto is_even = [](int value) { return value % 2 == 0; };
+    const auto is_negative = [](int value) { return value < 0; };
+    learn::function_ref<bool(int)> predicate = is_even;
+
+    ASSERT_EQ(learn::count_if(values.begin(), values.end(), predicate), 5);
+    ASSERT_EQ(*learn::find_if(values.begin(), values.end(), predicate), 0);
+
+    predicate = is_negative;
+    ASSERT_TRUE(learn::none_of(values.begin(), values.end(), predicate));
+}
@@ -0,0 +1,167 @@
+#include "learn_stl/mdspan.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "learn_stl/vector.h"
+
+static_assert(learn::extents<2, learn::dynamic_extent, 4>::rank() == 3, "");
+static_assert(learn::extents<2, learn::dynamic_extent, 4>::rank_dynamic() == 1, "");
+static_assert(sizeof(learn::dextents<2>) == 2 * sizeof(std::size_t), "");
+static_assert(sizeof(learn::extents<learn::dynamic_extent, 3>) == sizeof(std::size_t), "");
+static_assert(std::is_empty<learn::extents<2, 3>>::value, "");
+static_assert(learn::extents<2, 3>().size() == 6, "");
+static_assert(learn::layout_tiled<4, 8>::tile_size == 32, "");
+
+namespace {
+learn::vector<int> make_values(std::size_t count) {
+    learn::vector<int> values;
+    for (std::size_t i = 0; i < count; ++i) {
+        values.emplace_back(0);
+    }
+
+    return values;
+}
+
+// every index maps to a distinct offset within the span
+template <class Mapping>
+void expect_unique_offsets(const Mapping& mapping) {
+    std::set<std::size_t> offsets;
+    const auto& extents = mapping.extents();
+
+    for (std::size_t i = 0; i < extents.extent(0); ++i) {
+        for (std::size_t j = 0; j < extents.extent(1); ++j) {
+            const auto offset = mapping(i, j);
+            EXPECT_LT(offset, mapping.required_span_size());
+            offsets.insert(offset);
+        }
+    }
+
+    EXPECT_EQ(offsets.size(), extents.size());
+}
+}  // namespace
+
+TEST(Extents, staticAndDynamic) {
+    const learn::extents<2, learn::dynamic_extent, 4> extents(3);
+
+    EXPECT_EQ(extents.extent(0), 2u);
+    EXPECT_EQ(extents.extent(1), 3u);
+    EXPECT_EQ(extents.extent(2), 4u);
+    EXPECT_EQ(extents.size(), 24u);
+
+    EXPECT_TRUE(extents == (learn::dextents<3>(2, 3, 4)));
+    EXPECT_FALSE(extents == (learn::dextents<3>(2, 3, 5)));
+}
+
+TEST(Mdspan, rowAndColumnMajor) {
+    const learn::dextents<2> extents(3, 4);
+
+    const learn::layout_right::mapping<learn::dextents<2>> right(extents);
+    EXPECT_EQ(right(1, 2), 6u);
+    EXPECT_EQ(right.stride(0), 4u);
+    EXPECT_EQ(right.stride(1), 1u);
+
+    const learn::layout_left::mapping<learn::dextents<2>> left(extents);
+    EXPECT_EQ(left(1, 2), 7u);
+    EXPECT_EQ(left.stride(0), 1u);
+    EXPECT_EQ(left.stride(1), 3u);
+
+    expect_unique_offsets(right);
+    expect_unique_offsets(left);
+}
+
+TEST(Mdspan, accessVector) {
+    auto values = make_values(12);
+
+    learn::mdspan<int, learn::extents<3, 4>> matrix(values.data());
+    matrix(2, 1) = 5;
+    EXPECT_EQ(values[9], 5);
+
+    learn::mdspan<int, learn::dextents<2>, learn::layout_left> columns(values.data(), 3, 4);
+    EXPECT_EQ(columns(0, 3), values[9]);
+    EXPECT_EQ(columns.extent(1), 4u);
+    EXPECT_EQ(columns.size(), 12u);
+}
+
+TEST(Mdspan, strided) {
+    auto values = make_values(12);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i);
+    }
+
+    // every other column of a 3 by 4 row-major matrix
+    using Mapping = learn::layout_stride::mapping<learn::dextents<2>>;
+    const Mapping mapping(learn::dextents<2>(3, 2), {4, 2});
+    const learn::mdspan<int, learn::dextents<2>, learn::layout_stride> odd(values.data() + 1,
+                                                                            mapping);
+
+    EXPECT_EQ(odd(0, 0), 1);
+    EXPECT_EQ(odd(0, 1), 3);
+    EXPECT_EQ(odd(2, 1), 11);
+    EXPECT_EQ(mapping.required_span_size(), 11u);
+}
+
+TEST(Mdspan, tiled) {
+    using Layout = learn::layout_tiled<2, 4>;
+    const Layout::mapping<learn::dextents<2>> mapping(learn::dextents<2>(4, 8));
+
+    // the first tile holds rows 0-1 and columns 0-3, row-major
+    EXPECT_EQ(mapping(0, 0), 0u);
+    EXPECT_EQ(mapping(0, 3), 3u);
+    EXPECT_EQ(mapping(1, 0), 4u);
+    EXPECT_EQ(mapping(0, 4), 8u);
+    EXPECT_EQ(mapping(2, 0), 16u);
+    EXPECT_EQ(mapping.required_span_size(), 32u);
+    expect_unique_offsets(mapping);
+
+    // edge tiles are padded out to full size
+    const Layout::mapping<learn::dextents<2>> ragged(learn::dextents<2>(5, 7));
+    EXPECT_EQ(ragged.required_span_size(), 3u * 2u * Layout::tile_size);
+    expect_unique_offsets(ragged);
+}
+
+TEST(Mdspan, forEachTile) {
+    std::vector<std::pair<std::size_t, std::size_t>> tiles;
+    learn::for_each_tile<2, 3>(learn::dextents<2>(3, 5), [&](const auto& first, const auto& last) {
+        tiles.emplace_back(first[0] * 10 + first[1], last[0] * 10 + last[1]);
+    });
+
+    using Tile = std::pair<std::size_t, std::size_t>;
+    EXPECT_THAT(tiles, testing::ElementsAre(Tile(0, 23), Tile(3, 25), Tile(20, 33), Tile(23, 35)));
+
+    std::size_t visited = 0;
+    learn::for_each_tile<4, 4>(learn::dextents<2>(0, 5),
+                               [&](const auto&, const auto&) { ++visited; });
+    EXPECT_EQ(visited, 0u);
+}
+
+TEST(Mdspan, tiledTranspose) {
+    constexpr std::size_t rows = 7;
+    constexpr std::size_t cols = 10;
+
+    auto source_values = make_values(rows * cols);
+    auto target_values = make_values(rows * cols);
+    for (std::size_t i = 0; i < source_values.size(); ++i) {
+        source_values[i] = static_cast<int>(i);
+    }
+
+    const learn::mdspan<int, learn::dextents<2>> source(source_values.data(), rows, cols);
+    const learn::mdspan<int, learn::dextents<2>> target(target_values.data(), cols, rows);
+
+    std::size_t visited = 0;
+    learn::for_each_index_tiled<4, 4>(source.extents(), [&](std::size_t i, std::size_t j) {
+        target(j, i) = source(i, j);
+        ++visited;
+    });
+
+    EXPECT_EQ(visited, rows * cols);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            EXPECT_EQ(target(j, i), source(i, j));
+        }
+    }
+}
@@ -86,3 +86,109 @@ TYPED_TEST(MakeUniqueTest, Construct) {
     EXPECT_EQ(*(some_ptr.operator->()), some_value);
     EXPECT_TRUE(some_ptr);
 }
+
+TYPED_TEST(MakeUniqueTest, ForOverwrite) {
+    using learn::make_unique_for_overwrite;
+    using learn::unique_ptr;
+    auto some_ptr = make_unique_for_overwrite<TypeParam>();
+
+    ::testing::StaticAssertTypeEq<decltype(some_ptr), unique_ptr<TypeParam>>();
+    ASSERT_TRUE(some_ptr);
+
+    *some_ptr = helpers::generate<TypeParam>();
+    EXPECT_EQ(*some_ptr, helpers::generate<TypeParam>());
+}
+
+template <typename TypeT>
+class UniqueArrayTest : public ::testing::Test {};
+
+TYPED_TEST_SUITE(UniqueArrayTest, Types);
+
+TYPED_TEST(UniqueArrayTest, Ctors) {
+    using unique_ptr = learn::unique_ptr<TypeParam[]>;
+
+    unique_ptr empty_ptr;
+    EXPECT_FALSE(empty_ptr);
+
+    unique_ptr some_ptr(new TypeParam[4]);
+    EXPECT_TRUE(some_ptr);
+
+    some_ptr = nullptr;
+    EXPECT_FALSE(some_ptr);
+}
+
+TYPED_TEST(UniqueArrayTest, MakeUnique) {
+    using learn::make_unique;
+    using learn::unique_ptr;
+    constexpr auto count = std::size_t{16};
+
+    auto some_ptr = make_unique<TypeParam[]>(count);
+    ::testing::StaticAssertTypeEq<decltype(some_ptr), unique_ptr<TypeParam[]>>();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(some_ptr[i], TypeParam{});
+    }
+}
+
+TYPED_TEST(UniqueArrayTest, MakeUniqueForOverwrite) {
+    using learn::make_unique_for_overwrite;
+    using learn::unique_ptr;
+    constexpr auto count = std::size_t{16};
+
+    auto some_ptr = make_unique_for_overwrite<TypeParam[]>(count);
+    ::testing::StaticAssertTypeEq<decltype(some_ptr), unique_ptr<TypeParam[]>>();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        some_ptr[i] = helpers::generate<TypeParam>();
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(some_ptr[i], helpers::generate<TypeParam>());
+    }
+}
+
+TYPED_TEST(UniqueArrayTest, MoveAssign) {
+    using learn::make_unique;
+    using unique_ptr = learn::unique_ptr<TypeParam[]>;
+
+    auto some_ptr = make_unique<TypeParam[]>(3);
+    const auto raw_ptr = some_ptr.get();
+
+    unique_ptr other_ptr;
+    other_ptr = learn::move(some_ptr);
+
+    EXPECT_FALSE(some_ptr);
+    EXPECT_EQ(other_ptr.get(), raw_ptr);
+}
+
+TEST(AlignedAllocator, Alignment) {
+    using learn::aligned_allocator;
+
+    aligned_allocator<float, 32> allocator32;
+    aligned_allocator<double> allocator64;
+
+    for (std::size_t n : {1, 3, 17, 1000}) {
+        auto* values32 = allocator32.allocate(n);
+        auto* values64 = allocator64.allocate(n);
+
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values32) % 32, 0);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values64) % learn::cache_line_size, 0);
+
+        allocator32.deallocate(values32, n);
+        allocator64.deallocate(values64, n);
+    }
+}
+
+TEST(AlignedAllocator, Rebind) {
+    using Allocator = learn::aligned_allocator<double, 32>;
+    using Rebound = std::allocator_traits<Allocator>::rebind_alloc<char>;
+
+    ::testing::StaticAssertTypeEq<Rebound, learn::aligned_allocator<char, 32>>();
+    EXPECT_TRUE(Allocator() == Rebound());
+}
+
+TEST(AssumeAligned, ReturnsSamePointer) {
+    alignas(32) float values[8] = {};
+
+    EXPECT_EQ(learn::assume_aligned<32>(values), values);
+}
@@ -0,0 +1,135 @@
+#include "learn_stl/nullable_vector.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+// every third element is null
+learn::nullable_vector<int> make_column(int size) {
+    learn::nullable_vector<int> column;
+    for (int i = 0; i < size; ++i) {
+        if (i % 3 == 0) {
+            column.push_null();
+        } else {
+            column.push_back(i);
+        }
+    }
+
+    return column;
+}
+}  // namespace
+
+TEST(NullableVector, emptyConstruction) {
+    const learn::nullable_vector<double> column;
+
+    ASSERT_TRUE(column.empty());
+    ASSERT_EQ(column.size(), 0u);
+    ASSERT_EQ(column.null_count(), 0u);
+    ASSERT_EQ(learn::sum(column), 0.0);
+    ASSERT_EQ(learn::find_if(column, [](double) { return true; }), 0u);
+}
+
+TEST(NullableVector, pushBack) {
+    learn::nullable_vector<int> column;
+    column.push_back(1);
+    column.push_null();
+    column.push_back(learn::optional<int>(3));
+    column.push_back(learn::optional<int>());
+
+    ASSERT_EQ(column.size(), 4u);
+    ASSERT_EQ(column.null_count(), 2u);
+    ASSERT_TRUE(column.is_valid(0));
+    ASSERT_TRUE(column.is_null(1));
+    ASSERT_EQ(column.get(2).value(), 3);
+    ASSERT_FALSE(column.get(3).has_value());
+
+    // null slots hold a value initialised int
+    ASSERT_EQ(column.value(1), 0);
+}
+
+TEST(NullableVector, setAndSetNull) {
+    auto column = make_column(10);
+
+    column.set(0, 100);
+    column.set_null(1);
+
+    ASSERT_EQ(column.get(0).value(), 100);
+    ASSERT_TRUE(column.is_null(1));
+    ASSERT_EQ(column.value(1), 0);
+}
+
+TEST(NullableVector, bitmapLayout) {
+    const auto column = make_column(130);
+
+    ASSERT_EQ(column.validity().size(), 3u);
+    ASSERT_EQ(column.values().size(), 130u);
+
+    // bits past size() are clear
+    ASSERT_EQ(column.validity()[2] >> 2, 0u);
+}
+
+TEST(NullableVector, count) {
+    for (const int size : {0, 1, 63, 64, 65, 200}) {
+        const auto column = make_column(size);
+
+        std::size_t expected = 0;
+        for (int i = 0; i < size; ++i) {
+            expected += i % 3 != 0;
+        }
+
+        ASSERT_EQ(learn::count(column), expected);
+        ASSERT_EQ(column.null_count(), static_cast<std::size_t>(size) - expected);
+    }
+}
+
+TEST(NullableVector, countIf) {
+    const auto column = make_column(200);
+
+    const auto even = learn::count_if(column, [](int value) { return value % 2 == 0; });
+
+    std::size_t expected = 0;
+    for (int i = 0; i < 200; ++i) {
+        expected += i % 3 != 0 && i % 2 == 0;
+    }
+    ASSERT_EQ(even, expected);
+}
+
+TEST(NullableVector, sumSkipsNulls) {
+    learn::nullable_vector<int> column;
+    for (int i = 0; i < 200; ++i) {
+        // nulls are filled with a value which would change the sum
+        column.push_back(i);
+        if (i % 3 == 0) {
+            column.set_null(i);
+            column.value(i) = 1000;
+        }
+    }
+
+    int expected = 0;
+    for (int i = 0; i < 200; ++i) {
+        expected += i % 3 != 0 ? i : 0;
+    }
+    ASSERT_EQ(learn::sum(column), expected);
+    ASSERT_EQ(learn::reduce(column, 0L, [](long total, int) { return total + 1; }), 133);
+}
+
+TEST(NullableVector, sumDenseWords) {
+    learn::nullable_vector<double> column;
+    for (int i = 0; i < 128; ++i) {
+        column.push_back(1.0);
+    }
+
+    ASSERT_EQ(column.validity()[0], ~std::uint64_t(0));
+    ASSERT_EQ(learn::sum(column), 128.0);
+}
+
+TEST(NullableVector, findIf) {
+    const auto column = make_column(200);
+
+    ASSERT_EQ(learn::find_if(column, [](int value) { return value > 90; }), 91u);
+    // 150 itself is null
+    ASSERT_EQ(learn::find_if(column, [](int value) { return value >= 150; }), 151u);
+    ASSERT_EQ(learn::find_if(column, [](int value) { return value < 0; }), 200u);
+    // a null slot holds 0, but is never matched
+    ASSERT_EQ(learn::find_if(column, [](int value) { return value == 0; }), 200u);
+}
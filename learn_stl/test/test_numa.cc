@@ -0,0 +1,79 @@
+#include "learn_stl/numa.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "learn_stl/valarray.h"
+#include "learn_stl/vector.h"
+
+TEST(Numa, ParseIdList) {
+    using learn::detail::parse_id_list;
+
+    EXPECT_THAT(parse_id_list("0"), testing::ElementsAre(0));
+    EXPECT_THAT(parse_id_list("0-3,8,10-11\n"), testing::ElementsAre(0, 1, 2, 3, 8, 10, 11));
+}
+
+TEST(Numa, Topology) {
+    const auto num_nodes = learn::numa_node_count();
+    ASSERT_GE(num_nodes, 1);
+
+    const auto node = learn::numa_current_node();
+    EXPECT_GE(node, 0);
+    EXPECT_GE(learn::numa_node_of_cpu(0), 0);
+
+    int value = 3;
+    EXPECT_GE(learn::numa_node_of_address(&value), 0);
+}
+
+class NumaAllocatorTest : public ::testing::TestWithParam<learn::numa_policy> {};
+
+TEST_P(NumaAllocatorTest, Allocate) {
+    using Allocator = learn::numa_allocator<double>;
+    Allocator allocator(GetParam(), learn::numa_current_node());
+
+    for (std::size_t n : {1, 100, 1 << 16}) {
+        auto* values = allocator.allocate(n);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            values[i] = double(i);
+        }
+
+        EXPECT_EQ(values[n - 1], double(n - 1));
+        allocator.deallocate(values, n);
+    }
+}
+
+TEST_P(NumaAllocatorTest, Vector) {
+    using Allocator = learn::numa_allocator<int>;
+    using Vector = learn::vector<int, Allocator>;
+
+    Vector vector(100000, 3, Allocator(GetParam()));
+
+    ASSERT_THAT(vector, testing::SizeIs(100000));
+    EXPECT_THAT(vector, testing::Each(3));
+}
+
+TEST_P(NumaAllocatorTest, Valarray) {
+    using Allocator = learn::numa_allocator<double>;
+    using valarray = learn::valarray<double, Allocator>;
+
+    valarray val_a(0.5, 10000, Allocator(GetParam()));
+    valarray val_b(0.25, 10000, Allocator(GetParam()));
+
+    const valarray result = val_a + val_b;
+
+    EXPECT_EQ(result, valarray(0.75, 10000));
+}
+
+INSTANTIATE_TEST_SUITE_P(Policies, NumaAllocatorTest,
+                         testing::Values(learn::numa_policy::local, learn::numa_policy::interleave,
+                                         learn::numa_policy::bind));
+
+TEST(NumaAllocator, Equality) {
+    using learn::numa_allocator;
+    using learn::numa_policy;
+
+    EXPECT_TRUE(numa_allocator<int>() == numa_allocator<double>());
+    EXPECT_FALSE(numa_allocator<int>(numa_policy::bind, 0) ==
+                 numa_allocator<int>(numa_policy::interleave));
+}
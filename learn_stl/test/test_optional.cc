@@ -1,9 +1,14 @@
 #include "learn_stl/optional.h"
 
+#include <limits>
+#include <string>
+#include <type_traits>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "learn_stl/array.h"
+#include "learn_stl/vector.h"
 
 #include "helpers.h"
 
@@ -97,4 +102,194 @@ TYPED_TEST(OptionalTest, emplace) {
     optional.emplace(helpers::generate<TypeParam>());
 
     EXPECT_TRUE(helpers::equal(optional.value(), helpers::generate<TypeParam>()));
-}
\ No newline at end of file
+}
+
+namespace {
+// can only be built in place
+struct Immovable {
+    Immovable(int first, int second) : sum(first + second) {}
+    Immovable(const Immovable&) = delete;
+    Immovable(Immovable&&) = delete;
+
+    int sum;
+};
+}  // namespace
+
+TEST(Optional, emplaceInPlace) {
+    learn::optional<Immovable> optional;
+
+    auto& value = optional.emplace(1, 2);
+    ASSERT_TRUE(optional.has_value());
+    ASSERT_EQ(&value, &optional.value());
+    ASSERT_EQ(value.sum, 3);
+
+    optional.emplace(3, 4);
+    ASSERT_EQ(optional.value().sum, 7);
+}
+
+TEST(Optional, inPlaceConstruction) {
+    const learn::optional<Immovable> optional(learn::in_place, 5, 6);
+
+    ASSERT_TRUE(optional.has_value());
+    ASSERT_EQ(optional.value().sum, 11);
+}
+
+namespace {
+// counts live instances, so leaked or double destroyed values show up
+struct Counted {
+    static inline int alive = 0;
+
+    explicit Counted(int value) : value(value) { ++alive; }
+    Counted(const Counted& other) : value(other.value) { ++alive; }
+    Counted(Counted&& other) noexcept : value(other.value) { ++alive; }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) = default;
+    ~Counted() { --alive; }
+
+    int value;
+};
+}  // namespace
+
+static_assert(std::is_trivially_copyable<learn::optional<int>>::value, "");
+static_assert(std::is_trivially_destructible<learn::optional<learn::array<double, 3>>>::value, "");
+static_assert(!std::is_trivially_destructible<learn::optional<std::string>>::value, "");
+static_assert(!std::is_trivially_copy_constructible<learn::optional<std::string>>::value, "");
+static_assert(std::is_copy_constructible<learn::optional<std::string>>::value, "");
+static_assert(!std::is_copy_constructible<learn::optional<Immovable>>::value, "");
+
+TEST(Optional, destroysValue) {
+    ASSERT_EQ(Counted::alive, 0);
+    {
+        learn::optional<Counted> optional(learn::in_place, 1);
+        ASSERT_EQ(Counted::alive, 1);
+    }
+    ASSERT_EQ(Counted::alive, 0);
+
+    learn::optional<Counted> optional(learn::in_place, 2);
+    optional.reset();
+    ASSERT_FALSE(optional.has_value());
+    ASSERT_EQ(Counted::alive, 0);
+
+    optional.emplace(3);
+    optional.emplace(4);
+    ASSERT_EQ(Counted::alive, 1);
+    ASSERT_EQ(optional->value, 4);
+}
+
+TEST(Optional, assignsNonTrivial) {
+    {
+        learn::optional<Counted> full(learn::in_place, 1);
+        learn::optional<Counted> empty;
+
+        learn::optional<Counted> copy = full;
+        ASSERT_EQ(copy->value, 1);
+        ASSERT_EQ(Counted::alive, 2);
+
+        copy = empty;
+        ASSERT_FALSE(copy.has_value());
+        ASSERT_EQ(Counted::alive, 1);
+
+        copy = full;
+        ASSERT_EQ(copy->value, 1);
+        ASSERT_EQ(Counted::alive, 2);
+
+        learn::optional<Counted> moved = learn::move(copy);
+        ASSERT_EQ(moved->value, 1);
+
+        empty = learn::move(moved);
+        ASSERT_TRUE(empty.has_value());
+        ASSERT_EQ(empty->value, 1);
+
+        empty = Counted(5);
+        ASSERT_EQ(empty->value, 5);
+    }
+    ASSERT_EQ(Counted::alive, 0);
+}
+
+TEST(Optional, holdsVector) {
+    learn::optional<learn::vector<int>> optional;
+    ASSERT_FALSE(optional);
+
+    optional.emplace();
+    optional->emplace_back(1);
+    optional->emplace_back(2);
+
+    auto copy = optional;
+    ASSERT_EQ(copy->size(), 2u);
+    ASSERT_EQ((*copy)[1], 2);
+
+    optional.reset();
+    ASSERT_FALSE(optional);
+    ASSERT_EQ(copy.value_or(learn::vector<int>()).size(), 2u);
+}
+
+TEST(Optional, swapValues) {
+    learn::optional<std::string> lhs("left");
+    learn::optional<std::string> rhs;
+
+    learn::swap(lhs, rhs);
+    ASSERT_FALSE(lhs.has_value());
+    ASSERT_EQ(rhs.value(), "left");
+
+    lhs = std::string("right");
+    lhs.swap(rhs);
+    ASSERT_EQ(lhs.value(), "left");
+    ASSERT_EQ(rhs.value(), "right");
+}
+
+namespace {
+using CompactDouble = learn::optional<double, learn::nan_sentinel<double>>;
+using CompactIndex =
+    learn::optional<std::size_t,
+                    learn::value_sentinel<std::size_t, std::numeric_limits<std::size_t>::max()>>;
+using CompactPointer = learn::optional<const int*, learn::value_sentinel<const int*, nullptr>>;
+}  // namespace
+
+static_assert(sizeof(learn::optional<double>) == 2 * sizeof(double), "");
+static_assert(sizeof(CompactDouble) == sizeof(double), "");
+static_assert(sizeof(CompactIndex) == sizeof(std::size_t), "");
+static_assert(sizeof(CompactPointer) == sizeof(const int*), "");
+static_assert(sizeof(learn::array<CompactDouble, 4>) == 4 * sizeof(double), "");
+static_assert(std::is_trivially_copyable<CompactDouble>::value, "");
+
+TEST(CompactOptional, emptyIsSentinel) {
+    constexpr CompactIndex empty;
+    static_assert(!empty.has_value(), "");
+
+    const CompactDouble nan;
+    ASSERT_FALSE(nan);
+    ASSERT_THROW(nan.value(), std::bad_cast);
+    ASSERT_EQ(nan.value_or(2.5), 2.5);
+
+    const CompactPointer null;
+    ASSERT_FALSE(null.has_value());
+}
+
+TEST(CompactOptional, holdsValue) {
+    CompactDouble optional = 1.5;
+    ASSERT_TRUE(optional.has_value());
+    ASSERT_EQ(optional.value(), 1.5);
+    ASSERT_EQ(*optional, 1.5);
+
+    optional.reset();
+    ASSERT_FALSE(optional.has_value());
+
+    optional.emplace(3.0);
+    ASSERT_EQ(optional.value(), 3.0);
+
+    optional = std::numeric_limits<double>::quiet_NaN();
+    ASSERT_FALSE(optional.has_value());
+
+    const int value = 4;
+    CompactPointer pointer = &value;
+    ASSERT_EQ(**pointer, 4);
+}
+
+TEST(CompactOptional, swap) {
+    CompactIndex lhs = 3u;
+    CompactIndex rhs;
+
+    learn::swap(lhs, rhs);
+    ASSERT_FALSE(lhs.has_value());
+    ASSERT_EQ(rhs.value(), 3u);
+}
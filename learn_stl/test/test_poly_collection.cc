@@ -0,0 +1,144 @@
+#include "learn_stl/poly_collection.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace {
+struct Circle {
+    double radius;
+};
+
+struct Square {
+    double side;
+};
+
+struct Area {
+    double total = 0;
+
+    void operator()(const Circle& circle) { total += 3 * circle.radius * circle.radius; }
+    void operator()(const Square& square) { total += square.side * square.side; }
+};
+
+using Shapes = learn::poly_collection<Circle, Square>;
+}  // namespace
+
+TEST(PolyCollection, emptyConstruction) {
+    const Shapes shapes;
+
+    ASSERT_TRUE(shapes.empty());
+    ASSERT_EQ(shapes.size(), 0);
+    ASSERT_EQ(shapes.size<Circle>(), 0);
+}
+
+TEST(PolyCollection, insert) {
+    Shapes shapes;
+
+    shapes.insert(Circle{1});
+    shapes.insert(Square{2});
+    const Square square{3};
+    shapes.insert(square);
+    auto& circle = shapes.emplace<Circle>(Circle{4});
+
+    ASSERT_EQ(circle.radius, 4);
+    ASSERT_FALSE(shapes.empty());
+    ASSERT_EQ(shapes.size(), 4);
+    ASSERT_EQ(shapes.size<Circle>(), 2);
+    ASSERT_EQ(shapes.size<Square>(), 2);
+}
+
+TEST(PolyCollection, insertStandardLibraryTypes) {
+    // argument dependent lookup also finds std::forward for these
+    learn::poly_collection<std::string, int> values;
+
+    values.insert(std::string("first"));
+    values.emplace<std::string>(std::string("second"));
+    values.insert(3);
+
+    ASSERT_EQ(values.size<std::string>(), 2);
+    ASSERT_EQ(values.segment<std::string>()[1], "second");
+}
+
+TEST(PolyCollection, segmentsKeepInsertionOrder) {
+    Shapes shapes;
+
+    for (int i = 0; i < 10; ++i) {
+        shapes.insert(Circle{double(i)});
+        shapes.insert(Square{double(-i)});
+    }
+
+    const auto& circles = shapes.segment<Circle>();
+    const auto& squares = shapes.segment<Square>();
+    ASSERT_EQ(circles.size(), 10);
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(circles[i].radius, i);
+        ASSERT_EQ(squares[i].side, -i);
+    }
+}
+
+TEST(PolyCollection, forEach) {
+    Shapes shapes;
+    shapes.insert(Circle{1});
+    shapes.insert(Square{2});
+    shapes.insert(Circle{2});
+
+    const auto area = shapes.for_each(Area{});
+    ASSERT_EQ(area.total, 3 + 4 + 12);
+
+    // visits a whole type before the next, in the order the types are listed
+    std::string order;
+    shapes.for_each([&order](const auto& shape) {
+        order += std::is_same<std::decay_t<decltype(shape)>, Circle>::value ? 'c' : 's';
+    });
+    ASSERT_EQ(order, "ccs");
+}
+
+TEST(PolyCollection, forEachMutates) {
+    Shapes shapes;
+    shapes.insert(Circle{1});
+    shapes.insert(Square{2});
+
+    shapes.for_each([](auto& shape) {
+        if constexpr (std::is_same<std::decay_t<decltype(shape)>, Circle>::value) {
+            shape.radius *= 2;
+        } else {
+            shape.side *= 3;
+        }
+    });
+
+    ASSERT_EQ(shapes.segment<Circle>()[0].radius, 2);
+    ASSERT_EQ(shapes.segment<Square>()[0].side, 6);
+}
+
+TEST(PolyCollection, forEachSegment) {
+    learn::poly_collection<int, double> values;
+    values.insert(1);
+    values.insert(2.5);
+    values.insert(3);
+
+    std::size_t segments = 0;
+    double sum = 0;
+    values.for_each_segment([&](const auto& segment) {
+        segments += 1;
+        for (const auto value : segment) {
+            sum += value;
+        }
+    });
+
+    ASSERT_EQ(segments, 2);
+    ASSERT_EQ(sum, 6.5);
+}
+
+TEST(PolyCollection, clear) {
+    Shapes shapes;
+    shapes.reserve<Circle>(16);
+    shapes.insert(Circle{1});
+    shapes.insert(Square{2});
+
+    ASSERT_GE(shapes.segment<Circle>().capacity(), 16);
+
+    shapes.clear();
+    ASSERT_TRUE(shapes.empty());
+}
@@ -0,0 +1,103 @@
+#include "learn_stl/sorting_network.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+
+static_assert(learn::sorting_network<0>::size == 0, "");
+static_assert(learn::sorting_network<1>::size == 0, "");
+static_assert(learn::sorting_network<2>::size == 1, "");
+static_assert(learn::sorting_network<4>::size == 5, "");
+static_assert(learn::sorting_network<8>::size == 19, "");
+static_assert(learn::sorting_network<16>::size == 63, "");
+
+namespace {
+constexpr learn::array<int, 5> sorted_at_compile_time() {
+    learn::array<int, 5> values = {5, 1, 4, 2, 3};
+    learn::sort(values);
+    return values;
+}
+
+constexpr bool is_sorted_at_compile_time() {
+    const auto values = sorted_at_compile_time();
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (values[i] != static_cast<int>(i) + 1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static_assert(is_sorted_at_compile_time(), "");
+
+// by the 0-1 principle, a network that sorts every sequence of 0s and 1s sorts everything
+template <std::size_t N>
+void expect_sorts_zero_one() {
+    for (std::size_t bits = 0; bits < (std::size_t(1) << N); ++bits) {
+        learn::array<int, N> values;
+        for (std::size_t i = 0; i < N; ++i) {
+            values[i] = (bits >> i) & 1;
+        }
+
+        learn::sort(values);
+        ASSERT_TRUE(std::is_sorted(values.begin(), values.end())) << "N = " << N;
+    }
+}
+
+template <std::size_t N>
+void expect_matches_std_sort(std::mt19937& engine) {
+    std::uniform_int_distribution<int> distribution(-20, 20);
+
+    for (int trial = 0; trial < 100; ++trial) {
+        learn::array<int, N> values;
+        for (auto& value : values) {
+            value = distribution(engine);
+        }
+
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+
+        learn::sort(values);
+        ASSERT_EQ(values, expected) << "N = " << N;
+    }
+}
+
+template <std::size_t... Ns>
+void expect_matches_std_sort(std::mt19937& engine, std::index_sequence<Ns...>) {
+    (expect_matches_std_sort<Ns>(engine), ...);
+}
+}  // namespace
+
+TEST(SortingNetwork, zeroOnePrinciple) {
+    expect_sorts_zero_one<2>();
+    expect_sorts_zero_one<3>();
+    expect_sorts_zero_one<5>();
+    expect_sorts_zero_one<8>();
+    expect_sorts_zero_one<11>();
+    expect_sorts_zero_one<16>();
+}
+
+TEST(SortingNetwork, matchesStdSort) {
+    std::mt19937 engine(42);
+    expect_matches_std_sort(engine, std::make_index_sequence<33>());
+}
+
+TEST(SortingNetwork, comparator) {
+    learn::array<double, 6> values = {0.5, -1.0, 3.0, 2.0, 2.0, -4.0};
+    learn::sort(values, std::greater<double>());
+
+    EXPECT_THAT(values, testing::ElementsAre(3.0, 2.0, 2.0, 0.5, -1.0, -4.0));
+}
+
+TEST(SortingNetwork, nonArithmetic) {
+    learn::array<std::string, 4> values = {"pear", "apple", "fig", "banana"};
+    learn::sort(values);
+
+    EXPECT_THAT(values, testing::ElementsAre("apple", "banana", "fig", "pear"));
+}
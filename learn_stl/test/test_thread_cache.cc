@@ -0,0 +1,116 @@
+#include "learn_stl/thread_cache.h"
+
+#include <cstring>
+
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "learn_stl/vector.h"
+
+TEST(ThreadCache, SizeClasses) {
+    using namespace learn::detail;
+
+    EXPECT_EQ(heap_size_class(0), 0);
+    EXPECT_EQ(heap_size_class(heap_max_small_size), heap_num_classes - 1);
+
+    for (std::size_t num_bytes = 1; num_bytes <= heap_max_small_size; ++num_bytes) {
+        const auto size_class = heap_size_class(num_bytes);
+        ASSERT_LT(size_class, heap_num_classes);
+        ASSERT_GE(heap_class_size(size_class), num_bytes);
+        ASSERT_EQ(heap_class_size(size_class) % heap_alignment, 0);
+
+        if (size_class > 0) {
+            ASSERT_LT(heap_class_size(size_class - 1), num_bytes);
+        }
+    }
+}
+
+TEST(ThreadCache, AllocateSizes) {
+    using learn::thread_caching_heap;
+
+    for (std::size_t num_bytes : {1, 16, 17, 100, 1000, 4096, 32768, 32769, 1 << 20}) {
+        auto* ptr = static_cast<char*>(thread_caching_heap::allocate(num_bytes));
+
+        ASSERT_TRUE(ptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % thread_caching_heap::max_alignment, 0);
+
+        std::memset(ptr, 0xab, num_bytes);
+        thread_caching_heap::deallocate(ptr, num_bytes);
+    }
+}
+
+TEST(ThreadCache, DistinctObjects) {
+    using learn::thread_caching_heap;
+    constexpr std::size_t num_objects = 10000;
+    constexpr std::size_t num_bytes = 48;
+
+    std::vector<int*> ptrs;
+    for (std::size_t i = 0; i < num_objects; ++i) {
+        ptrs.push_back(static_cast<int*>(thread_caching_heap::allocate(num_bytes)));
+        *ptrs.back() = int(i);
+    }
+
+    for (std::size_t i = 0; i < num_objects; ++i) {
+        ASSERT_EQ(*ptrs[i], int(i));
+        thread_caching_heap::deallocate(ptrs[i], num_bytes);
+    }
+
+    thread_caching_heap::release_free_memory();
+}
+
+TEST(ThreadCache, CrossThreadChurn) {
+    using learn::thread_caching_heap;
+    constexpr int num_threads = 8;
+    constexpr int num_iterations = 2000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([t] {
+            std::vector<std::pair<char*, std::size_t>> live;
+
+            for (int i = 0; i < num_iterations; ++i) {
+                const auto num_bytes = std::size_t(1 + (i * 37 + t * 101) % 2000);
+                auto* ptr = static_cast<char*>(thread_caching_heap::allocate(num_bytes));
+                ptr[0] = char(t);
+                ptr[num_bytes - 1] = char(t);
+                live.emplace_back(ptr, num_bytes);
+
+                if (i % 3 == 0) {
+                    auto [old_ptr, old_bytes] = live.front();
+                    ASSERT_EQ(old_ptr[0], char(t));
+                    ASSERT_EQ(old_ptr[old_bytes - 1], char(t));
+                    thread_caching_heap::deallocate(old_ptr, old_bytes);
+                    live.erase(live.begin());
+                }
+            }
+
+            for (auto [ptr, num_bytes] : live) {
+                thread_caching_heap::deallocate(ptr, num_bytes);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST(ThreadCache, FreeOnOtherThread) {
+    using learn::thread_caching_heap;
+    constexpr std::size_t num_objects = 1000;
+
+    std::vector<void*> ptrs;
+    std::thread producer([&ptrs] {
+        for (std::size_t i = 0; i < num_objects; ++i) {
+            ptrs.push_back(thread_caching_heap::allocate(64));
+        }
+    });
+    producer.join();
+
+    for (auto* ptr : ptrs) {
+        thread_caching_heap::deallocate(ptr, 64);
+    }
+}
@@ -6,6 +6,9 @@
 #include <string>
 #include <vector>
 
+#include "learn_stl/any.h"
+#include "learn_stl/vector.h"
+
 TEST(Tuple, Create) {
     using Tuple = learn::tuple<int, float, char>;
     ASSERT_NO_THROW({ const auto tuple = Tuple(2, 0.3f, 'a'); });
@@ -15,7 +18,7 @@ TEST(Tuple, Create) {
 TEST(Tuple, EmptyTuple) {
     using Tuple = learn::tuple<>;
 
-    // ASSERT_NO_THROW({ Tuple tuple; });
+    ASSERT_NO_THROW({ [[maybe_unused]] Tuple tuple; });
 };
 
 TEST(Tuple, tuple_element_t) {
@@ -67,4 +70,207 @@ TEST(Tuple, getConst) {
 
     EXPECT_EQ(learn::get<0>(tuple), "hello world");
     EXPECT_EQ(learn::get<1>(tuple), vector_data);
-}
\ No newline at end of file
+}
+
+namespace {
+struct Empty {};
+
+struct EmptyLess {
+    bool operator()(int lhs, int rhs) const { return lhs < rhs; }
+};
+
+struct FinalEmpty final {};
+}  // namespace
+
+static_assert(sizeof(learn::tuple<Empty, int>) == sizeof(int), "");
+static_assert(sizeof(learn::tuple<int, EmptyLess>) == sizeof(int), "");
+static_assert(sizeof(learn::tuple<Empty, EmptyLess, double>) == sizeof(double), "");
+static_assert(sizeof(learn::tuple<FinalEmpty, int>) == 2 * sizeof(int), "");
+
+static_assert(sizeof(learn::tuple<char, double, char, int>) == 24, "");
+static_assert(sizeof(learn::packed_tuple<char, double, char, int>) == 16, "");
+static_assert(sizeof(learn::packed_tuple<char, Empty, double>) == 16, "");
+static_assert(learn::packed_tuple<char, double, char, int>::position<1> == 0, "");
+static_assert(learn::packed_tuple<char, double, char, int>::position<3> == 1, "");
+static_assert(learn::packed_tuple<char, double, char, int>::position<0> == 2, "");
+static_assert(learn::packed_tuple<char, double, char, int>::position<2> == 3, "");
+
+TEST(Tuple, emptyBaseGet) {
+    learn::tuple<EmptyLess, int> tuple(EmptyLess{}, 3);
+
+    EXPECT_TRUE(learn::get<0>(tuple)(1, 2));
+    EXPECT_EQ(learn::get<1>(tuple), 3);
+
+    learn::get<1>(tuple) = 4;
+    EXPECT_EQ(learn::get<1>(tuple), 4);
+
+    const learn::tuple<FinalEmpty, int> with_final(FinalEmpty{}, 5);
+    EXPECT_EQ(learn::get<1>(with_final), 5);
+}
+
+TEST(Tuple, nestedEmpty) {
+    // the inner tuple's empty leaf mustn't become a second base of the outer tuple
+    learn::tuple<Empty, learn::tuple<Empty>> nested;
+    learn::get<0>(nested) = Empty{};
+    learn::get<0>(learn::get<1>(nested)) = Empty{};
+
+    const learn::tuple<EmptyLess, learn::tuple<EmptyLess, int>> values(
+        EmptyLess{}, learn::tuple<EmptyLess, int>(EmptyLess{}, 6));
+    EXPECT_TRUE(learn::get<0>(values)(1, 2));
+    EXPECT_EQ(learn::get<1>(learn::get<1>(values)), 6);
+
+    learn::packed_tuple<Empty, learn::packed_tuple<Empty, int>> packed(
+        Empty{}, learn::packed_tuple<Empty, int>(Empty{}, 7));
+    EXPECT_EQ(learn::get<1>(learn::get<1>(packed)), 7);
+}
+
+static_assert(std::is_trivially_copyable<learn::tuple<int, double, char>>::value, "");
+static_assert(std::is_trivially_copyable<learn::tuple<Empty, int>>::value, "");
+static_assert(!std::is_trivially_copyable<learn::tuple<int, std::string>>::value, "");
+
+TEST(Tuple, assign) {
+    using Tuple = learn::tuple<int, std::string>;
+    Tuple tuple(1, std::string("one"));
+    Tuple other(2, std::string("two"));
+
+    tuple = other;
+    EXPECT_EQ(learn::get<0>(tuple), 2);
+    EXPECT_EQ(learn::get<1>(tuple), "two");
+
+    tuple = Tuple(3, std::string("three"));
+    EXPECT_EQ(learn::get<0>(tuple), 3);
+    EXPECT_EQ(learn::get<1>(tuple), "three");
+}
+
+TEST(Tuple, relocateInVector) {
+    learn::vector<learn::tuple<int, double>> tuples;
+    for (int i = 0; i < 100; ++i) {
+        tuples.emplace_back(i, i * 0.5);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(learn::get<0>(tuples[i]), i);
+        EXPECT_EQ(learn::get<1>(tuples[i]), i * 0.5);
+    }
+}
+
+TEST(Tuple, references) {
+    int value = 1;
+    std::string text = "text";
+    learn::tuple<int&, const std::string&> tuple(value, text);
+
+    learn::get<0>(tuple) = 2;
+    EXPECT_EQ(value, 2);
+    EXPECT_EQ(&learn::get<1>(tuple), &text);
+}
+
+TEST(Tuple, copyNonConstLvalue) {
+    // any can be built from the tuple itself, which mustn't take the copy away from the copy
+    // constructor
+    learn::tuple<learn::any> tuple(learn::any(3));
+    learn::tuple<learn::any> copy(tuple);
+    EXPECT_EQ(learn::any_cast<int>(learn::get<0>(copy)), 3);
+
+    learn::tuple<learn::any> moved(learn::move(copy));
+    EXPECT_EQ(learn::any_cast<int>(learn::get<0>(moved)), 3);
+}
+
+TEST(Tuple, structuredBindings) {
+    learn::tuple<int, std::string> tuple(1, std::string("one"));
+
+    auto& [number, name] = tuple;
+    number = 2;
+    EXPECT_EQ(learn::get<0>(tuple), 2);
+    EXPECT_EQ(name, "one");
+
+    auto [moved_number, moved_name] = learn::tuple<int, std::string>(3, std::string("three"));
+    EXPECT_EQ(moved_number, 3);
+    EXPECT_EQ(moved_name, "three");
+}
+
+TEST(Tuple, apply) {
+    const learn::tuple<int, int, int> tuple(1, 2, 3);
+    EXPECT_EQ(learn::apply([](int a, int b, int c) { return a * 100 + b * 10 + c; }, tuple), 123);
+
+    // the elements of an rvalue tuple are moved into the call
+    learn::tuple<std::string> strings(std::string("moved"));
+    const auto taken = learn::apply([](std::string s) { return s; }, learn::move(strings));
+    EXPECT_EQ(taken, "moved");
+
+    // and of an lvalue tuple are passed by reference
+    learn::tuple<int> counter(0);
+    learn::apply([](int& count) { ++count; }, counter);
+    EXPECT_EQ(learn::get<0>(counter), 1);
+
+    constexpr auto sum =
+        learn::apply([](int a, int b) { return a + b; }, learn::tuple<int, int>(4, 5));
+    static_assert(sum == 9, "");
+}
+
+TEST(Tuple, tupleCat) {
+    const learn::tuple<int, char> first(1, 'a');
+    learn::tuple<std::string> second(std::string("second"));
+
+    auto joined = learn::tuple_cat(first, learn::tuple<>(), learn::move(second),
+                                   learn::tuple<double>(2.5));
+    testing::StaticAssertTypeEq<decltype(joined), learn::tuple<int, char, std::string, double>>();
+
+    EXPECT_EQ(learn::get<0>(joined), 1);
+    EXPECT_EQ(learn::get<1>(joined), 'a');
+    EXPECT_EQ(learn::get<2>(joined), "second");
+    EXPECT_EQ(learn::get<3>(joined), 2.5);
+
+    testing::StaticAssertTypeEq<decltype(learn::tuple_cat()), learn::tuple<>>();
+}
+
+TEST(PackedTuple, getKeepsDeclarationOrder) {
+    using Tuple = learn::packed_tuple<char, double, std::string, int>;
+    testing::StaticAssertTypeEq<learn::tuple_element_t<2, Tuple>, std::string>();
+    static_assert(learn::tuple_size<Tuple>::value == 4, "");
+
+    Tuple tuple('a', 2.5, std::string("packed"), 7);
+
+    EXPECT_EQ(learn::get<0>(tuple), 'a');
+    EXPECT_EQ(learn::get<1>(tuple), 2.5);
+    EXPECT_EQ(learn::get<2>(tuple), "packed");
+    EXPECT_EQ(learn::get<3>(tuple), 7);
+
+    learn::get<0>(tuple) = 'b';
+    const Tuple& view = tuple;
+    EXPECT_EQ(learn::get<0>(view), 'b');
+}
+
+TEST(PackedTuple, constructFromLvalues) {
+    const char c = 'x';
+    const double d = 1.5;
+    const learn::packed_tuple<char, double> tuple(c, d);
+
+    EXPECT_EQ(learn::get<0>(tuple), 'x');
+    EXPECT_EQ(learn::get<1>(tuple), 1.5);
+}
+
+TEST(IndexSequence, makeIndexSequence) {
+    testing::StaticAssertTypeEq<learn::make_index_sequence<0>::type, learn::index_sequence<>>();
+    testing::StaticAssertTypeEq<learn::make_index_sequence<1>::type, learn::index_sequence<0>>();
+    testing::StaticAssertTypeEq<learn::make_index_sequence<5>::type,
+                                learn::index_sequence<0, 1, 2, 3, 4>>();
+
+    // the fallback used without compiler builtins
+    testing::StaticAssertTypeEq<learn::detail::split_index_sequence<0>::type,
+                                learn::index_sequence<>>();
+    testing::StaticAssertTypeEq<learn::detail::split_index_sequence<7>::type,
+                                learn::make_index_sequence<7>::type>();
+    testing::StaticAssertTypeEq<learn::detail::split_index_sequence<1000>::type,
+                                learn::make_index_sequence<1000>::type>();
+}
+
+TEST(IndexSequence, typeAtIndex) {
+    using Types = learn::tuple<int, float, int, char>;
+    testing::StaticAssertTypeEq<learn::tuple_element_t<2, Types>, int>();
+    testing::StaticAssertTypeEq<learn::tuple_element_t<3, Types>, char>();
+
+    testing::StaticAssertTypeEq<
+        learn::detail::overload_type_at_index<1, int, const float&, int>::type, const float&>();
+    testing::StaticAssertTypeEq<
+        learn::detail::overload_type_at_index<2, int, const float&, int>::type, int>();
+}
@@ -63,4 +63,18 @@ TEST(valarray, Modulo) {
 
     valarray val_expt(423 % 32, 20);
     EXPECT_EQ(result, val_expt);
-}
\ No newline at end of file
+}
+
+TEST(valarray, Aligned) {
+    using valarray = learn::aligned_valarray<float>;
+    valarray val_a(0.35f, 20);
+    valarray val_b(0.232f, 20);
+
+    const valarray result = val_a + val_b;
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(result.data()) % learn::cache_line_size, 0);
+    EXPECT_EQ(learn::assume_aligned<learn::cache_line_size>(result.data()), result.data());
+
+    valarray val_expt(0.35f + 0.232f, 20);
+    EXPECT_EQ(result, val_expt);
+}
@@ -3,6 +3,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <string>
+
+#include "learn_stl/vector.h"
+
 TEST(Variant, DetailIndexOf) {
     using learn::detail::index_of;
 
@@ -96,4 +100,529 @@ TEST(Variant, ConstIndexGet) {
 
     ASSERT_THROW(get<1>(value), bad_variant_access);
     ASSERT_THROW(get<2>(value), bad_variant_access);
-}
\ No newline at end of file
+}
+
+TEST(Variant, HoldsAlternative) {
+    using learn::holds_alternative;
+    using learn::variant;
+
+    variant<int, double, char> value = 'a';
+    ASSERT_TRUE(holds_alternative<char>(value));
+    ASSERT_FALSE(holds_alternative<int>(value));
+
+    value = 1.5;
+    ASSERT_TRUE(holds_alternative<double>(value));
+}
+
+TEST(Variant, NonTrivialAlternative) {
+    using learn::get;
+    using learn::variant;
+
+    variant<int, std::string> value = std::string(64, 'x');
+    ASSERT_EQ(get<std::string>(value), std::string(64, 'x'));
+
+    auto copy = value;
+    ASSERT_EQ(get<1>(copy), std::string(64, 'x'));
+
+    auto moved = std::move(copy);
+    ASSERT_EQ(get<1>(moved), std::string(64, 'x'));
+
+    value = 3;
+    ASSERT_EQ(get<int>(value), 3);
+
+    value = moved;
+    ASSERT_EQ(get<std::string>(value), std::string(64, 'x'));
+}
+
+namespace {
+struct Tracked {
+    static inline int alive = 0;
+
+    Tracked() { ++alive; }
+    Tracked(const Tracked&) { ++alive; }
+    Tracked(Tracked&&) noexcept { ++alive; }
+    ~Tracked() { --alive; }
+};
+}  // namespace
+
+TEST(Variant, Lifetime) {
+    using learn::variant;
+
+    Tracked::alive = 0;
+
+    {
+        variant<Tracked, int> value;
+        ASSERT_EQ(Tracked::alive, 1);
+
+        auto copy = value;
+        auto moved = std::move(copy);
+        ASSERT_EQ(Tracked::alive, 3);
+
+        value = 4;
+        ASSERT_EQ(Tracked::alive, 2);
+
+        copy = 5;
+        ASSERT_EQ(Tracked::alive, 1);
+    }
+
+    ASSERT_EQ(Tracked::alive, 0);
+}
+
+TEST(Variant, Visit) {
+    using learn::variant;
+    using learn::visit;
+
+    struct Name {
+        std::string operator()(int) const { return "int"; }
+        std::string operator()(double) const { return "double"; }
+        std::string operator()(char) const { return "char"; }
+    };
+
+    variant<int, double, char> value = 'a';
+    ASSERT_EQ(visit(Name{}, value), "char");
+
+    value = 1.5;
+    ASSERT_EQ(visit(Name{}, value), "double");
+
+    visit([](auto& alternative) { alternative *= 2; }, value);
+    ASSERT_EQ(learn::get<double>(value), 3.0);
+
+    const variant<int, double, char> const_value = 4;
+    ASSERT_EQ(visit([](const auto& alternative) { return double(alternative); }, const_value), 4.0);
+}
+
+TEST(Variant, VisitRvalue) {
+    using learn::variant;
+    using learn::visit;
+
+    variant<int, std::string> value = std::string("moved");
+
+    const auto result = visit(
+        [](auto&& alternative) -> std::string {
+            if constexpr (std::is_same<std::decay_t<decltype(alternative)>, std::string>::value) {
+                static_assert(std::is_rvalue_reference<decltype(alternative)>::value);
+                return std::move(alternative);
+            } else {
+                return "int";
+            }
+        },
+        std::move(value));
+
+    ASSERT_EQ(result, "moved");
+}
+
+TEST(Variant, VisitMultiple) {
+    using learn::variant;
+    using learn::visit;
+
+    const auto combine = [](auto lhs, auto rhs, auto extra) { return double(lhs + rhs) + extra; };
+
+    variant<int, double> lhs = 1;
+    variant<int, double, char> rhs = 'a';
+    variant<double> extra = 0.5;
+
+    ASSERT_EQ(visit(combine, lhs, rhs, extra), 1 + 'a' + 0.5);
+
+    lhs = 2.5;
+    rhs = 3;
+    ASSERT_EQ(visit(combine, lhs, rhs, extra), 6.0);
+
+    ASSERT_EQ(visit([]() { return 7; }), 7);
+}
+
+TEST(Variant, VisitManyAlternatives) {
+    using learn::variant;
+    using learn::visit;
+
+    using Value = variant<std::integral_constant<int, 0>, std::integral_constant<int, 1>,
+                          std::integral_constant<int, 2>, std::integral_constant<int, 3>,
+                          std::integral_constant<int, 4>, std::integral_constant<int, 5>,
+                          std::integral_constant<int, 6>, std::integral_constant<int, 7>,
+                          std::integral_constant<int, 8>, std::integral_constant<int, 9>>;
+    static_assert(learn::variant_size_v<Value> == 10);
+
+    Value value = std::integral_constant<int, 7>{};
+    ASSERT_EQ(value.index(), 7);
+    ASSERT_EQ(visit([](auto alternative) { return alternative.value; }, value), 7);
+}
+
+namespace {
+enum class Token : std::uint8_t { word, number, symbol, invalid };
+
+struct Eof {};
+struct Error {};
+}  // namespace
+
+template <>
+struct learn::niche_traits<Token> : learn::enum_niche<Token, Token::invalid> {};
+
+template <>
+struct learn::niche_traits<const int*> : learn::aligned_pointer_niche<int> {};
+
+TEST(Variant, CompactIndex) {
+    using learn::variant;
+    using learn::detail::variant_index_t;
+
+    static_assert(std::is_same<variant_index_t<2>, std::uint8_t>::value);
+    static_assert(std::is_same<variant_index_t<255>, std::uint8_t>::value);
+    static_assert(std::is_same<variant_index_t<256>, std::uint16_t>::value);
+    static_assert(std::is_same<variant_index_t<70000>, std::uint32_t>::value);
+
+    static_assert(sizeof(variant<int, float>) == 8);
+    static_assert(sizeof(variant<char, bool>) == 2);
+    static_assert(sizeof(variant<double, char>) == 16);
+    static_assert(sizeof(variant<std::uint16_t, char>) == 4);
+}
+
+TEST(Variant, NicheSize) {
+    using learn::monostate;
+    using learn::variant;
+
+    static_assert(sizeof(variant<Token, Eof>) == sizeof(Token));
+    static_assert(sizeof(variant<Eof, const int*>) == sizeof(const int*));
+    static_assert(sizeof(variant<Eof, Error, monostate, const int*>) == sizeof(const int*));
+
+    // not enough spare patterns, or an alternative that isn't an empty tag
+    static_assert(sizeof(variant<Token, Eof, Error>) == 2 * sizeof(Token));
+    static_assert(sizeof(variant<Token, int>) == 2 * sizeof(int));
+    static_assert(sizeof(variant<Token>) == 2 * sizeof(Token));
+}
+
+TEST(Variant, NicheEnum) {
+    using learn::get;
+    using learn::holds_alternative;
+    using learn::variant;
+
+    variant<Token, Eof> value = Token::number;
+    ASSERT_EQ(value.index(), 0);
+    ASSERT_EQ(get<Token>(value), Token::number);
+
+    value = Eof{};
+    ASSERT_EQ(value.index(), 1);
+    ASSERT_TRUE(holds_alternative<Eof>(value));
+
+    auto copy = value;
+    ASSERT_EQ(copy.index(), 1);
+
+    value = Token::word;
+    copy = value;
+    ASSERT_EQ(get<0>(copy), Token::word);
+
+    variant<Eof, Token> eof_first;
+    ASSERT_EQ(eof_first.index(), 0);
+    eof_first = Token::symbol;
+    ASSERT_EQ(eof_first.index(), 1);
+}
+
+TEST(Variant, NichePointer) {
+    using learn::monostate;
+    using learn::variant;
+    using learn::visit;
+
+    const int number = 3;
+    variant<Eof, Error, monostate, const int*> value = &number;
+    ASSERT_EQ(value.index(), 3);
+
+    // nullptr is a valid pointer, not a niche
+    value = static_cast<const int*>(nullptr);
+    ASSERT_EQ(value.index(), 3);
+
+    value = Error{};
+    ASSERT_EQ(value.index(), 1);
+
+    value = monostate{};
+    ASSERT_EQ(value.index(), 2);
+
+    value = &number;
+    const auto read = [](const auto& alternative) {
+        if constexpr (std::is_same<std::decay_t<decltype(alternative)>, const int*>::value) {
+            return *alternative;
+        } else {
+            return -1;
+        }
+    };
+    ASSERT_EQ(visit(read, value), 3);
+}
+
+TEST(Variant, TrivialSpecialMembers) {
+    using learn::variant;
+    using Trivial = variant<int, float, double>;
+
+    static_assert(std::is_trivially_destructible<Trivial>::value);
+    static_assert(std::is_trivially_copy_constructible<Trivial>::value);
+    static_assert(std::is_trivially_move_constructible<Trivial>::value);
+    static_assert(std::is_trivially_copy_assignable<Trivial>::value);
+    static_assert(std::is_trivially_move_assignable<Trivial>::value);
+    static_assert(std::is_trivially_copyable<Trivial>::value);
+
+    using NonTrivial = variant<int, std::string>;
+    static_assert(!std::is_trivially_destructible<NonTrivial>::value);
+    static_assert(!std::is_trivially_copy_constructible<NonTrivial>::value);
+    static_assert(!std::is_trivially_move_constructible<NonTrivial>::value);
+    static_assert(!std::is_trivially_copyable<NonTrivial>::value);
+    static_assert(std::is_copy_constructible<NonTrivial>::value);
+    static_assert(std::is_nothrow_destructible<NonTrivial>::value);
+
+    // a trivially destructible alternative with a user-provided copy constructor
+    struct Counted {
+        Counted() = default;
+        Counted(const Counted&) {}
+    };
+    using Mixed = variant<int, Counted>;
+    static_assert(std::is_trivially_destructible<Mixed>::value);
+    static_assert(!std::is_trivially_copy_constructible<Mixed>::value);
+    static_assert(!std::is_trivially_copy_assignable<Mixed>::value);
+}
+
+TEST(Variant, DeletedSpecialMembers) {
+    using learn::variant;
+
+    struct MoveOnly {
+        MoveOnly() = default;
+        MoveOnly(const MoveOnly&) = delete;
+        MoveOnly(MoveOnly&&) = default;
+        MoveOnly& operator=(MoveOnly&&) = default;
+    };
+    using Movable = variant<int, MoveOnly>;
+    static_assert(!std::is_copy_constructible<Movable>::value);
+    static_assert(!std::is_copy_assignable<Movable>::value);
+    static_assert(std::is_move_constructible<Movable>::value);
+    static_assert(std::is_move_assignable<Movable>::value);
+
+    Movable value = 3;
+    Movable moved = std::move(value);
+    ASSERT_EQ(moved.index(), 0);
+
+    struct Pinned {
+        Pinned() = default;
+        Pinned(const Pinned&) = delete;
+        Pinned(Pinned&&) = delete;
+    };
+    static_assert(!std::is_copy_constructible<variant<Pinned, int>>::value);
+    static_assert(!std::is_move_constructible<variant<Pinned, int>>::value);
+}
+
+TEST(Variant, TrivialReallocation) {
+    using learn::get;
+    using learn::variant;
+
+    learn::vector<variant<int, float, double>> values;
+    for (int i = 0; i < 100; ++i) {
+        if (i % 2 == 0) {
+            values.emplace_back(i);
+        } else {
+            values.emplace_back(double(i));
+        }
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(values[i].index(), i % 2 == 0 ? 0 : 2);
+    }
+    ASSERT_EQ(get<double>(values[99]), 99.0);
+}
+
+namespace {
+// can only be built in place
+struct Immovable {
+    Immovable(int first, int second) : sum(first + second) {}
+    Immovable(const Immovable&) = delete;
+    Immovable(Immovable&&) = delete;
+
+    int sum;
+};
+
+struct ThrowsOnConstruct {
+    explicit ThrowsOnConstruct(bool fail) {
+        if (fail) {
+            throw std::runtime_error("construct");
+        }
+    }
+    ThrowsOnConstruct(const ThrowsOnConstruct&) = delete;
+    ThrowsOnConstruct(ThrowsOnConstruct&&) = delete;
+};
+
+struct ThrowsOnMove {
+    static inline int alive = 0;
+
+    explicit ThrowsOnMove(bool fail) : fail(fail) { ++alive; }
+    ThrowsOnMove(const ThrowsOnMove& other) : fail(other.fail) { ++alive; }
+    ThrowsOnMove(ThrowsOnMove&& other) : fail(other.fail) {
+        if (fail) {
+            throw std::runtime_error("move");
+        }
+        ++alive;
+    }
+    ~ThrowsOnMove() { --alive; }
+
+    bool fail;
+};
+}  // namespace
+
+TEST(Variant, InPlaceConstruction) {
+    using learn::get;
+    using learn::in_place_index;
+    using learn::in_place_type;
+    using learn::variant;
+
+    variant<int, Immovable> by_index(in_place_index<1>, 2, 3);
+    ASSERT_EQ(by_index.index(), 1);
+    ASSERT_EQ(get<1>(by_index).sum, 5);
+
+    variant<int, Immovable> by_type(in_place_type<Immovable>, 4, 5);
+    ASSERT_EQ(get<Immovable>(by_type).sum, 9);
+
+    variant<std::string, int> string(in_place_index<0>, 3, 'x');
+    ASSERT_EQ(get<0>(string), "xxx");
+}
+
+TEST(Variant, Emplace) {
+    using learn::get;
+    using learn::variant;
+
+    variant<int, Immovable, std::string> value;
+
+    auto& immovable = value.emplace<1>(1, 2);
+    ASSERT_EQ(value.index(), 1);
+    ASSERT_EQ(immovable.sum, 3);
+
+    auto& string = value.emplace<std::string>(2, 'y');
+    ASSERT_EQ(value.index(), 2);
+    ASSERT_EQ(string, "yy");
+
+    value.emplace<int>(7);
+    ASSERT_EQ(get<int>(value), 7);
+}
+
+TEST(Variant, EmplaceThrows) {
+    using learn::get;
+    using learn::variant;
+
+    // the string is built aside and moved in, so a failure leaves the old value
+    variant<int, std::string> value = 3;
+    ASSERT_THROW(value.emplace<1>(std::size_t(-1), 'x'), std::exception);
+    ASSERT_EQ(get<int>(value), 3);
+
+    // this can't be built aside, so the variant falls back to its first alternative
+    variant<int, ThrowsOnConstruct> fallback(learn::in_place_index<1>, false);
+    ASSERT_THROW(fallback.emplace<1>(true), std::runtime_error);
+    ASSERT_EQ(fallback.index(), 0);
+}
+
+TEST(Variant, AssignThrows) {
+    using learn::variant;
+
+    ThrowsOnMove::alive = 0;
+
+    {
+        // the held value is destroyed before the move throws, so the variant falls back to its
+        // first alternative rather than destroy it again
+        variant<int, ThrowsOnMove> value(learn::in_place_index<1>, false);
+        variant<int, ThrowsOnMove> source(learn::in_place_index<1>, true);
+        ASSERT_EQ(ThrowsOnMove::alive, 2);
+
+        ASSERT_THROW(value = std::move(source), std::runtime_error);
+        ASSERT_EQ(value.index(), 0);
+        ASSERT_EQ(ThrowsOnMove::alive, 1);
+
+        value.emplace<1>(false);
+        ASSERT_THROW(value = source, std::runtime_error);
+        ASSERT_EQ(value.index(), 0);
+        ASSERT_EQ(ThrowsOnMove::alive, 1);
+    }
+
+    ASSERT_EQ(ThrowsOnMove::alive, 0);
+}
+
+TEST(Variant, AssignSameAlternative) {
+    using learn::get;
+    using learn::variant;
+
+    variant<int, std::string> value = std::string("first");
+    // assigns to the held string rather than destroying it first
+    const std::string& held = get<std::string>(value);
+    value = held;
+    ASSERT_EQ(get<std::string>(value), "first");
+    ASSERT_EQ(&held, &get<std::string>(value));
+
+    value = std::string("second");
+    ASSERT_EQ(get<std::string>(value), "second");
+}
+
+namespace {
+using Instruction = learn::variant<int, double, std::string>;
+
+learn::vector<Instruction> make_instructions() {
+    learn::vector<Instruction> instructions;
+    instructions.emplace_back(1);
+    instructions.emplace_back(std::string("a"));
+    instructions.emplace_back(2.5);
+    instructions.emplace_back(2);
+    instructions.emplace_back(std::string("b"));
+    instructions.emplace_back(3);
+    return instructions;
+}
+
+struct Recorder {
+    std::string trace;
+
+    void operator()(int value) { trace += "i" + std::to_string(value); }
+    void operator()(double value) { trace += "d" + std::to_string(int(value * 10)); }
+    void operator()(const std::string& value) { trace += "s" + value; }
+};
+}  // namespace
+
+TEST(Variant, VisitBatched) {
+    const auto instructions = make_instructions();
+
+    Recorder recorder;
+    learn::visit_batched(instructions, recorder);
+
+    // grouped by alternative, each group in its original order
+    ASSERT_EQ(recorder.trace, "i1i2i3d25sasb");
+}
+
+TEST(Variant, VisitBatchedMutates) {
+    auto instructions = make_instructions();
+
+    learn::visit_batched(instructions, [](auto& value) { value = value + value; });
+
+    ASSERT_EQ(learn::get<int>(instructions[0]), 2);
+    ASSERT_EQ(learn::get<std::string>(instructions[1]), "aa");
+    ASSERT_EQ(learn::get<double>(instructions[2]), 5.0);
+}
+
+TEST(Variant, VisitBatchedEmpty) {
+    learn::vector<Instruction> instructions;
+
+    int calls = 0;
+    learn::visit_batched(instructions, [&calls](const auto&) { ++calls; });
+    learn::visit_batched_unstable(instructions, [&calls](const auto&) { ++calls; });
+    ASSERT_EQ(calls, 0);
+}
+
+TEST(Variant, VisitBatchedUnstable) {
+    auto instructions = make_instructions();
+
+    std::string kinds;
+    int int_sum = 0;
+    learn::visit_batched_unstable(instructions, [&](const auto& value) {
+        using Value = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same<Value, int>::value) {
+            kinds += 'i';
+            int_sum += value;
+        } else if constexpr (std::is_same<Value, double>::value) {
+            kinds += 'd';
+        } else {
+            kinds += 's';
+        }
+    });
+
+    ASSERT_EQ(kinds, "iiidss");
+    ASSERT_EQ(int_sum, 6);
+
+    // the range itself is left grouped by alternative
+    const std::size_t expected[] = {0, 0, 0, 1, 2, 2};
+    for (std::size_t i = 0; i < instructions.size(); ++i) {
+        ASSERT_EQ(instructions[i].index(), expected[i]);
+    }
+}
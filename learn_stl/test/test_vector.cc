@@ -161,4 +161,63 @@ TEST(Vector, EraseSingle) {
     ASSERT_EQ(vector.size(), 4);
 
     ASSERT_THAT(vector, testing::ElementsAre(1.5, 2.0, 3.0, 3.2));
-}
\ No newline at end of file
+}
+
+TEST(Vector, AlignedAllocator) {
+    using Vector = learn::vector<double, learn::aligned_allocator<double, 32>>;
+
+    Vector vector;
+    for (int i = 0; i < 100; ++i) {
+        vector.emplace_back(i);
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(vector.data()) % 32, 0);
+    }
+
+    EXPECT_EQ(vector[42], 42.0);
+}
+
+TEST(Vector, CopyConstruct) {
+    using Vector = learn::vector<double>;
+
+    Vector vector;
+    vector.emplace_back(1.0);
+    vector.emplace_back(1.5);
+
+    Vector copy = vector;
+    copy.emplace_back(2.0);
+
+    ASSERT_THAT(vector, testing::ElementsAre(1.0, 1.5));
+    ASSERT_THAT(copy, testing::ElementsAre(1.0, 1.5, 2.0));
+}
+
+TEST(Vector, MoveConstruct) {
+    using Vector = learn::vector<double>;
+
+    Vector vector;
+    vector.emplace_back(1.0);
+    vector.emplace_back(1.5);
+    const auto data = vector.data();
+
+    Vector moved = learn::move(vector);
+
+    ASSERT_EQ(vector.size(), 0);
+    ASSERT_EQ(moved.data(), data);
+    ASSERT_THAT(moved, testing::ElementsAre(1.0, 1.5));
+}
+
+TEST(Vector, Assign) {
+    using Vector = learn::vector<double>;
+
+    Vector vector;
+    vector.emplace_back(1.0);
+
+    Vector other;
+    other.emplace_back(3.0);
+    other.emplace_back(4.0);
+
+    vector = other;
+    ASSERT_THAT(vector, testing::ElementsAre(3.0, 4.0));
+
+    other = Vector();
+    ASSERT_EQ(other.size(), 0);
+    ASSERT_THAT(vector, testing::ElementsAre(3.0, 4.0));
+}
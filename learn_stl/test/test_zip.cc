@@ -0,0 +1,122 @@
+#include "learn_stl/zip.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <list>
+#include <string>
+
+#include "learn_stl/algorithm.h"
+#include "learn_stl/array.h"
+#include "learn_stl/vector.h"
+
+namespace {
+template <typename Value>
+learn::vector<Value> make_vector(std::initializer_list<Value> values) {
+    learn::vector<Value> result;
+    for (const auto& value : values) {
+        result.emplace_back(value);
+    }
+
+    return result;
+}
+}  // namespace
+
+TEST(Zip, iteratorCategory) {
+    using Vectors = learn::zip_iterator_t<learn::vector<int>, const learn::vector<double>>;
+    testing::StaticAssertTypeEq<Vectors::iterator_category, std::random_access_iterator_tag>();
+    testing::StaticAssertTypeEq<Vectors::reference, learn::tuple<int&, const double&>>();
+    testing::StaticAssertTypeEq<Vectors::value_type, learn::tuple<int, double>>();
+
+    using WithList = learn::zip_iterator_t<learn::vector<int>, std::list<int>>;
+    testing::StaticAssertTypeEq<WithList::iterator_category, std::bidirectional_iterator_tag>();
+}
+
+TEST(Zip, shortestRange) {
+    auto ids = make_vector({1, 2, 3, 4});
+    auto names = make_vector<std::string>({"a", "b", "c"});
+
+    const auto view = learn::zip(ids, names);
+    EXPECT_EQ(view.size(), 3u);
+    EXPECT_EQ(std::distance(view.begin(), view.end()), 3);
+    EXPECT_EQ(learn::get<1>(view[2]), "c");
+}
+
+TEST(Zip, forEachWritesInPlace) {
+    auto xs = make_vector({1, 2, 3});
+    auto ys = make_vector({10, 20, 30});
+    auto sums = make_vector({0, 0, 0});
+
+    const auto view = learn::zip(xs, ys, sums);
+    learn::for_each(view.begin(), view.end(),
+                    [](auto row) { learn::get<2>(row) = learn::get<0>(row) + learn::get<1>(row); });
+
+    EXPECT_THAT(sums, testing::ElementsAre(11, 22, 33));
+}
+
+TEST(Zip, findIf) {
+    auto ids = make_vector({4, 8, 15, 16});
+    auto names = make_vector<std::string>({"four", "eight", "fifteen", "sixteen"});
+
+    const auto view = learn::zip(ids, names);
+    const auto found = learn::find_if(view.begin(), view.end(),
+                                      [](const auto& row) { return learn::get<0>(row) > 10; });
+
+    ASSERT_NE(found, view.end());
+    EXPECT_EQ(learn::get<1>(*found), "fifteen");
+    EXPECT_EQ(found - view.begin(), 2);
+}
+
+TEST(Zip, mismatch) {
+    auto a = make_vector({1, 2, 3});
+    auto b = make_vector({'a', 'b', 'c'});
+    auto c = make_vector({1, 2, 4});
+    auto d = make_vector({'a', 'b', 'c'});
+
+    const auto left = learn::zip(a, b);
+    const auto right = learn::zip(c, d);
+    const auto result = learn::mismatch(left.begin(), left.end(), right.begin(),
+                                        [](const auto& x, const auto& y) { return x == y; });
+
+    EXPECT_EQ(result.first - left.begin(), 2);
+    EXPECT_EQ(learn::get<0>(*result.second), 4);
+}
+
+TEST(Zip, sortByKey) {
+    auto keys = make_vector({3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5, 8, 9, 7, 9, 3, 2, 3, 8, 4});
+    auto values = make_vector<std::string>({"3", "1", "4", "1", "5", "9", "2", "6", "5", "3",
+                                            "5", "8", "9", "7", "9", "3", "2", "3", "8", "4"});
+
+    const auto view = learn::zip(keys, values);
+    std::sort(view.begin(), view.end(), [](const auto& x, const auto& y) {
+        return learn::get<0>(x) < learn::get<0>(y);
+    });
+
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(values[i], std::to_string(keys[i]));
+    }
+}
+
+TEST(Zip, sortLexicographically) {
+    learn::array<int, 4> major = {2, 1, 2, 1};
+    learn::array<int, 4> minor = {1, 2, 0, 1};
+
+    const auto view = learn::zip(major, minor);
+    std::sort(view.begin(), view.end());
+
+    EXPECT_THAT(major, testing::ElementsAre(1, 1, 2, 2));
+    EXPECT_THAT(minor, testing::ElementsAre(1, 2, 0, 1));
+}
+
+TEST(Zip, reverseBidirectional) {
+    std::list<int> list = {1, 2, 3};
+    auto vector = make_vector({'a', 'b', 'c'});
+
+    const auto view = learn::zip(list, vector);
+    std::reverse(view.begin(), view.end());
+
+    EXPECT_THAT(list, testing::ElementsAre(3, 2, 1));
+    EXPECT_THAT(vector, testing::ElementsAre('c', 'b', 'a'));
+}
@@ -0,0 +1,563 @@
+#pragma once
+
+#include <sys/mman.h>
+
+#include <cstdint>
+
+#include <map>
+#include <mutex>
+#include <new>
+
+namespace learn {
+namespace detail {
+
+inline constexpr std::size_t heap_page_shift = 12;
+inline constexpr std::size_t heap_page_size = std::size_t{1} << heap_page_shift;
+inline constexpr std::size_t heap_alignment = 16;
+inline constexpr std::size_t heap_max_small_size = 32 * 1024;
+inline constexpr std::size_t heap_num_classes = 40;
+// pages requested from the OS at a time
+inline constexpr std::size_t heap_grow_pages = 256;
+// free pages the page heap holds on to before handing them back to the OS
+inline constexpr std::size_t heap_release_threshold = 32 * 1024 * 1024;
+// bytes a thread cache holds on to before returning half of every free list
+inline constexpr std::size_t heap_max_thread_cache = 2 * 1024 * 1024;
+
+// sizes up to 128 bytes are spaced by 16 bytes, then each power of two is split into four classes
+constexpr std::size_t heap_size_class(std::size_t num_bytes) {
+    if (num_bytes <= 128) {
+        return num_bytes == 0 ? 0 : (num_bytes - 1) / 16;
+    }
+
+    const std::size_t k = 63 - __builtin_clzll(num_bytes - 1);
+    return 8 + (k - 7) * 4 + ((num_bytes - 1 - (std::size_t{1} << k)) >> (k - 2));
+}
+
+constexpr std::size_t heap_class_size(std::size_t size_class) {
+    if (size_class < 8) {
+        return 16 * (size_class + 1);
+    }
+
+    const std::size_t k = 7 + (size_class - 8) / 4;
+    return (std::size_t{1} << k) + ((size_class - 8) % 4 + 1) * (std::size_t{1} << (k - 2));
+}
+
+// number of objects moved between a thread cache and the central free list at once
+constexpr std::size_t heap_batch_size(std::size_t size_class) {
+    const auto num_objects = 64 * 1024 / heap_class_size(size_class);
+    return num_objects < 2 ? 2 : (num_objects > 32 ? 32 : num_objects);
+}
+
+constexpr std::size_t heap_span_pages(std::size_t size_class) {
+    const auto num_bytes = heap_class_size(size_class) * heap_batch_size(size_class);
+    return (num_bytes + heap_page_size - 1) / heap_page_size;
+}
+
+struct heap_object {
+    heap_object* next;
+};
+
+// a run of contiguous pages, either free in the page heap, carved into objects of one size
+// class, or handed out whole for a large allocation
+struct heap_span {
+    std::uintptr_t start = 0;
+    std::size_t num_pages = 0;
+    std::size_t size_class = heap_num_classes;
+
+    bool is_free = false;
+    bool is_released = false;
+
+    heap_object* objects = nullptr;
+    std::size_t num_allocated = 0;
+    heap_span* prev = nullptr;
+    heap_span* next = nullptr;
+
+    void* address() const { return reinterpret_cast<void*>(start << heap_page_shift); }
+};
+
+// two level radix tree from page number to span, leaves are only touched once used
+class heap_page_map {
+  public:
+    heap_span* get(std::uintptr_t page) const {
+        const auto* leaf = root_[page >> leaf_bits];
+        return leaf ? leaf[page & (leaf_size - 1)] : nullptr;
+    }
+
+    void set(std::uintptr_t page, heap_span* span) {
+        auto*& leaf = root_[page >> leaf_bits];
+
+        if (!leaf) {
+            void* ptr = ::mmap(nullptr, leaf_size * sizeof(heap_span*), PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            leaf = static_cast<heap_span**>(ptr);
+        }
+
+        leaf[page & (leaf_size - 1)] = span;
+    }
+
+  private:
+    static constexpr std::size_t address_bits = 48;
+    static constexpr std::size_t leaf_bits = 20;
+    static constexpr std::size_t leaf_size = std::size_t{1} << leaf_bits;
+    static constexpr std::size_t root_size = std::size_t{1}
+                                             << (address_bits - heap_page_shift - leaf_bits);
+
+    heap_span** root_[root_size] = {};
+};
+
+class heap_page_heap {
+  public:
+    heap_span* allocate(std::size_t num_pages) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto iter = free_spans_.lower_bound(num_pages);
+        if (iter == free_spans_.end()) {
+            grow(num_pages);
+            iter = free_spans_.lower_bound(num_pages);
+        }
+
+        heap_span* span = iter->second;
+        remove_free(iter);
+
+        if (span->num_pages > num_pages) {
+            auto* rest = new heap_span;
+            rest->start = span->start + num_pages;
+            rest->num_pages = span->num_pages - num_pages;
+            rest->is_released = span->is_released;
+            span->num_pages = num_pages;
+            insert_free(rest);
+        }
+
+        span->is_free = false;
+        page_map_.set(span->start, span);
+        page_map_.set(span->start + span->num_pages - 1, span);
+
+        return span;
+    }
+
+    // maps every page of the span, so that span_of works for any object carved from it
+    void map_pages(heap_span* span) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (std::size_t i = 0; i < span->num_pages; ++i) {
+            page_map_.set(span->start + i, span);
+        }
+    }
+
+    void deallocate(heap_span* span) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        span->size_class = heap_num_classes;
+        span->objects = nullptr;
+        span->num_allocated = 0;
+
+        coalesce(span);
+        insert_free(span);
+
+        if (unreleased_pages_ * heap_page_size > heap_release_threshold) {
+            release_locked();
+        }
+    }
+
+    // only valid for pointers into a span that is in use, and for large spans only their start
+    heap_span* span_of(const void* ptr) const {
+        return page_map_.get(reinterpret_cast<std::uintptr_t>(ptr) >> heap_page_shift);
+    }
+
+    heap_span* lock_and_span_of(const void* ptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return span_of(ptr);
+    }
+
+    void release_free_memory() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        release_locked();
+    }
+
+  private:
+    using FreeSpans = std::multimap<std::size_t, heap_span*>;
+
+    std::mutex mutex_;
+    FreeSpans free_spans_;
+    heap_page_map page_map_;
+    std::size_t unreleased_pages_ = 0;
+
+    void grow(std::size_t num_pages) {
+        num_pages = num_pages < heap_grow_pages ? heap_grow_pages : num_pages;
+
+        void* ptr = ::mmap(nullptr, num_pages * heap_page_size, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        // fresh mappings aren't backed by physical pages yet, so they count as released
+        auto* span = new heap_span;
+        span->start = reinterpret_cast<std::uintptr_t>(ptr) >> heap_page_shift;
+        span->num_pages = num_pages;
+        span->is_released = true;
+
+        coalesce(span);
+        insert_free(span);
+    }
+
+    // merges span with free neighbours; the first and last page of every free span are kept in
+    // the page map for exactly this lookup
+    void coalesce(heap_span* span) {
+        heap_span* prev = page_map_.get(span->start - 1);
+        if (prev && prev->is_free) {
+            remove_free(find_free(prev));
+            span->start = prev->start;
+            span->num_pages += prev->num_pages;
+            span->is_released = span->is_released && prev->is_released;
+            delete prev;
+        }
+
+        heap_span* next = page_map_.get(span->start + span->num_pages);
+        if (next && next->is_free) {
+            remove_free(find_free(next));
+            span->num_pages += next->num_pages;
+            span->is_released = span->is_released && next->is_released;
+            delete next;
+        }
+    }
+
+    FreeSpans::iterator find_free(heap_span* span) {
+        auto range = free_spans_.equal_range(span->num_pages);
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            if (iter->second == span) {
+                return iter;
+            }
+        }
+
+        return free_spans_.end();
+    }
+
+    void insert_free(heap_span* span) {
+        span->is_free = true;
+        page_map_.set(span->start, span);
+        page_map_.set(span->start + span->num_pages - 1, span);
+        free_spans_.emplace(span->num_pages, span);
+
+        if (!span->is_released) {
+            unreleased_pages_ += span->num_pages;
+        }
+    }
+
+    void remove_free(FreeSpans::iterator iter) {
+        heap_span* span = iter->second;
+        free_spans_.erase(iter);
+
+        if (!span->is_released) {
+            unreleased_pages_ -= span->num_pages;
+        }
+    }
+
+    void release_locked() {
+        for (auto& [num_pages, span] : free_spans_) {
+            if (!span->is_released) {
+                ::madvise(span->address(), num_pages * heap_page_size, MADV_DONTNEED);
+                span->is_released = true;
+            }
+        }
+
+        unreleased_pages_ = 0;
+    }
+};
+
+class heap_central_list {
+  public:
+    void init(std::size_t size_class, heap_page_heap* page_heap) {
+        size_class_ = size_class;
+        page_heap_ = page_heap;
+    }
+
+    // removes up to num_objects objects, returning how many were linked into head
+    std::size_t remove_range(heap_object*& head, std::size_t num_objects) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t count = 0;
+
+        for (; count < num_objects; ++count) {
+            if (!nonempty_) {
+                populate();
+            }
+
+            heap_span* span = nonempty_;
+            heap_object* object = span->objects;
+            span->objects = object->next;
+            span->num_allocated += 1;
+
+            if (!span->objects) {
+                unlink(span);
+            }
+
+            object->next = head;
+            head = object;
+        }
+
+        return count;
+    }
+
+    // returns a null terminated list of objects, spans which become empty go to the page heap
+    void insert_range(heap_object* head) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        while (head) {
+            heap_object* object = head;
+            head = head->next;
+
+            heap_span* span = page_heap_->span_of(object);
+            if (!span->objects) {
+                link(span);
+            }
+
+            object->next = span->objects;
+            span->objects = object;
+            span->num_allocated -= 1;
+
+            if (span->num_allocated == 0) {
+                unlink(span);
+                page_heap_->deallocate(span);
+            }
+        }
+    }
+
+  private:
+    std::mutex mutex_;
+    std::size_t size_class_ = 0;
+    heap_page_heap* page_heap_ = nullptr;
+    heap_span* nonempty_ = nullptr;
+
+    void populate() {
+        heap_span* span = page_heap_->allocate(heap_span_pages(size_class_));
+        span->size_class = size_class_;
+        page_heap_->map_pages(span);
+
+        const auto object_size = heap_class_size(size_class_);
+        const auto num_objects = span->num_pages * heap_page_size / object_size;
+        auto* base = static_cast<char*>(span->address());
+
+        for (std::size_t i = num_objects; i > 0; --i) {
+            auto* object = reinterpret_cast<heap_object*>(base + (i - 1) * object_size);
+            object->next = span->objects;
+            span->objects = object;
+        }
+
+        link(span);
+    }
+
+    void link(heap_span* span) {
+        span->prev = nullptr;
+        span->next = nonempty_;
+        if (nonempty_) {
+            nonempty_->prev = span;
+        }
+        nonempty_ = span;
+    }
+
+    void unlink(heap_span* span) {
+        if (span->prev) {
+            span->prev->next = span->next;
+        } else {
+            nonempty_ = span->next;
+        }
+
+        if (span->next) {
+            span->next->prev = span->prev;
+        }
+
+        span->prev = nullptr;
+        span->next = nullptr;
+    }
+};
+
+struct heap_globals {
+    heap_page_heap page_heap;
+    heap_central_list central_lists[heap_num_classes];
+
+    heap_globals() {
+        for (std::size_t i = 0; i < heap_num_classes; ++i) {
+            central_lists[i].init(i, &page_heap);
+        }
+    }
+};
+
+// never destroyed, thread caches flush into it during static destruction
+inline heap_globals& heap_instance() {
+    static heap_globals* globals = new heap_globals();
+    return *globals;
+}
+
+class heap_thread_cache {
+  public:
+    heap_thread_cache() = default;
+    heap_thread_cache(const heap_thread_cache&) = delete;
+    heap_thread_cache& operator=(const heap_thread_cache&) = delete;
+
+    ~heap_thread_cache() {
+        for (std::size_t i = 0; i < heap_num_classes; ++i) {
+            release(i, lists_[i].length);
+        }
+    }
+
+    void* allocate(std::size_t size_class) {
+        auto& list = lists_[size_class];
+
+        if (!list.head) {
+            fetch(size_class);
+        }
+
+        heap_object* object = list.head;
+        list.head = object->next;
+        list.length -= 1;
+        num_bytes_ -= heap_class_size(size_class);
+
+        return object;
+    }
+
+    void deallocate(void* ptr, std::size_t size_class) {
+        auto& list = lists_[size_class];
+
+        auto* object = static_cast<heap_object*>(ptr);
+        object->next = list.head;
+        list.head = object;
+        list.length += 1;
+        num_bytes_ += heap_class_size(size_class);
+
+        if (list.length > list.max_length) {
+            release(size_class, heap_batch_size(size_class));
+        }
+
+        if (num_bytes_ > heap_max_thread_cache) {
+            scavenge();
+        }
+    }
+
+  private:
+    struct free_list {
+        heap_object* head = nullptr;
+        std::size_t length = 0;
+        std::size_t max_length = 1;
+    };
+
+    free_list lists_[heap_num_classes];
+    std::size_t num_bytes_ = 0;
+
+    // slow start, a thread only caches a full batch after asking for objects repeatedly
+    void fetch(std::size_t size_class) {
+        auto& list = lists_[size_class];
+        const auto batch_size = heap_batch_size(size_class);
+        const auto num_objects = list.max_length < batch_size ? list.max_length : batch_size;
+
+        auto& central_list = heap_instance().central_lists[size_class];
+        const auto count = central_list.remove_range(list.head, num_objects);
+
+        list.length += count;
+        num_bytes_ += count * heap_class_size(size_class);
+
+        if (list.max_length < batch_size) {
+            list.max_length += 1;
+        }
+    }
+
+    void release(std::size_t size_class, std::size_t num_objects) {
+        auto& list = lists_[size_class];
+        num_objects = num_objects < list.length ? num_objects : list.length;
+
+        if (num_objects == 0) {
+            return;
+        }
+
+        heap_object* head = list.head;
+        heap_object* tail = head;
+        for (std::size_t i = 1; i < num_objects; ++i) {
+            tail = tail->next;
+        }
+
+        list.head = tail->next;
+        list.length -= num_objects;
+        num_bytes_ -= num_objects * heap_class_size(size_class);
+
+        tail->next = nullptr;
+        heap_instance().central_lists[size_class].insert_range(head);
+    }
+
+    void scavenge() {
+        for (std::size_t i = 0; i < heap_num_classes; ++i) {
+            release(i, (lists_[i].length + 1) / 2);
+        }
+    }
+};
+
+// trivially destructible, so it can still be read after the thread's cache has been destroyed
+inline thread_local bool heap_thread_cache_destroyed = false;
+
+inline heap_thread_cache* heap_local_cache() {
+    if (heap_thread_cache_destroyed) {
+        return nullptr;
+    }
+
+    struct holder {
+        heap_thread_cache cache;
+        ~holder() { heap_thread_cache_destroyed = true; }
+    };
+
+    thread_local holder local;
+    return &local.cache;
+}
+
+}  // namespace detail
+
+// a size-class heap in the style of tcmalloc; small objects come from a per-thread cache which
+// exchanges batches with a central free list per size class, and both are backed by a page heap
+// of spans which returns idle pages to the OS
+class thread_caching_heap {
+  public:
+    static constexpr std::size_t max_alignment = detail::heap_alignment;
+
+    static void* allocate(std::size_t num_bytes) {
+        if (num_bytes > detail::heap_max_small_size) {
+            const auto num_pages =
+                (num_bytes + detail::heap_page_size - 1) / detail::heap_page_size;
+            return detail::heap_instance().page_heap.allocate(num_pages)->address();
+        }
+
+        const auto size_class = detail::heap_size_class(num_bytes);
+
+        if (auto* cache = detail::heap_local_cache()) {
+            return cache->allocate(size_class);
+        }
+
+        detail::heap_object* object = nullptr;
+        detail::heap_instance().central_lists[size_class].remove_range(object, 1);
+        return object;
+    }
+
+    static void deallocate(void* ptr, std::size_t num_bytes) {
+        auto& heap = detail::heap_instance();
+
+        if (num_bytes > detail::heap_max_small_size) {
+            heap.page_heap.deallocate(heap.page_heap.lock_and_span_of(ptr));
+            return;
+        }
+
+        const auto size_class = detail::heap_size_class(num_bytes);
+
+        if (auto* cache = detail::heap_local_cache()) {
+            cache->deallocate(ptr, size_class);
+            return;
+        }
+
+        auto* object = static_cast<detail::heap_object*>(ptr);
+        object->next = nullptr;
+        heap.central_lists[size_class].insert_range(object);
+    }
+
+    // hands every free page in the page heap back to the OS with madvise(MADV_DONTNEED)
+    static void release_free_memory() { detail::heap_instance().page_heap.release_free_memory(); }
+};
+
+}  // namespace learn
@@ -2,7 +2,9 @@
 
 #include <cstdlib>
 
+#include <functional>
 #include <type_traits>
+#include <utility>
 
 #include "utility.h"
 
@@ -11,32 +13,142 @@ namespace detail {
 template <typename Sequences, typename... Types>
 struct tuple;
 
-template <std::size_t I, typename Type>
+// empty types are inherited from rather than stored, so they take up no space; final types can't
+// be inherited from, and are stored like any other
+template <typename Type>
+inline constexpr bool tuple_leaf_ebo = std::is_empty<Type>::value && !std::is_final<Type>::value;
+
+template <std::size_t I, typename Type, bool = tuple_leaf_ebo<Type>>
 struct tuple_leaf {
   public:
     using type = Type;
+    constexpr tuple_leaf() : value_() {}
     explicit constexpr tuple_leaf(const type& value) : value_(value) {}
-    explicit constexpr tuple_leaf(Type&& value) : value_(move(value)) {}
+    template <typename Arg>
+    constexpr tuple_leaf(in_place_t, Arg&& arg) : value_(::learn::forward<Arg>(arg)) {}
+
+    constexpr Type& get() noexcept { return value_; }
+    constexpr const Type& get() const noexcept { return value_; }
 
     Type value_;
 };
 
+// assigning a reference element assigns the object it refers to, as with std::tuple, rather than
+// leaving the tuple unassignable; a tuple of references is what a zip iterator dereferences to
+template <std::size_t I, typename Type>
+struct tuple_leaf<I, Type&, false> {
+  public:
+    using type = Type&;
+    explicit constexpr tuple_leaf(Type& value) : value_(value) {}
+    template <typename Arg>
+    constexpr tuple_leaf(in_place_t, Arg&& arg) : value_(::learn::forward<Arg>(arg)) {}
+
+    tuple_leaf(const tuple_leaf&) = default;
+    constexpr tuple_leaf& operator=(const tuple_leaf& other) {
+        value_ = other.value_;
+        return *this;
+    }
+
+    constexpr Type& get() const noexcept { return value_; }
+
+    Type& value_;
+};
+
+// privately inherited, so the empty type's members don't leak into the tuple
+template <std::size_t I, typename Type>
+struct tuple_leaf<I, Type, true> : private Type {
+  public:
+    using type = Type;
+    constexpr tuple_leaf() : Type() {}
+    explicit constexpr tuple_leaf(const type& value) : Type(value) {}
+    template <typename Arg>
+    constexpr tuple_leaf(in_place_t, Arg&& arg) : Type(::learn::forward<Arg>(arg)) {}
+
+    constexpr Type& get() noexcept { return *this; }
+    constexpr const Type& get() const noexcept { return *this; }
+};
+
 template <std::size_t... Indices, typename... Types>
 struct tuple<index_sequence<Indices...>, Types...> : tuple_leaf<Indices, Types>... {
+    tuple() = default;
     explicit constexpr tuple(const Types&... elements) : tuple_leaf<Indices, Types>(elements)... {}
-    explicit constexpr tuple(Types&&... elements)
-        : tuple_leaf<Indices, Types>(forward<Types>(elements))... {}
+    template <typename... Args>
+    constexpr tuple(in_place_t, Args&&... elements)
+        : tuple_leaf<Indices, Types>(in_place, ::learn::forward<Args>(elements))... {}
+
+    template <typename... Others>
+    constexpr tuple(const tuple<index_sequence<Indices...>, Others...>& other)
+        : tuple_leaf<Indices, Types>(
+              in_place, static_cast<const tuple_leaf<Indices, Others>&>(other).get())... {}
+    template <typename... Others>
+    constexpr tuple(tuple<index_sequence<Indices...>, Others...>&& other)
+        : tuple_leaf<Indices, Types>(
+              in_place, ::learn::forward<Others>(
+                            static_cast<tuple_leaf<Indices, Others>&>(other).get()))... {}
+
+    template <typename... Others>
+    constexpr void assign(const tuple<index_sequence<Indices...>, Others...>& other) {
+        ((tuple_leaf<Indices, Types>::get() =
+              static_cast<const tuple_leaf<Indices, Others>&>(other).get()),
+         ...);
+    }
+
+    template <typename... Others>
+    constexpr void assign(tuple<index_sequence<Indices...>, Others...>&& other) {
+        ((tuple_leaf<Indices, Types>::get() =
+              ::learn::forward<Others>(static_cast<tuple_leaf<Indices, Others>&>(other).get())),
+         ...);
+    }
 };
 
-template <size_t I, typename Head, typename... Tail>
-struct type_at_index {
-    using type = typename type_at_index<I - 1, Tail...>::type;
+// tuple and packed_tuple hold their leaves in a member rather than inheriting them, so an empty
+// element which is itself a tuple doesn't give the outer tuple a second base of the same type
+struct tuple_access {
+    template <class Tuple>
+    static constexpr auto& impl(Tuple& data) noexcept {
+        return data.impl_;
+    }
 };
 
-template <typename Head, typename... Tail>
-struct type_at_index<0, Head, Tail...> {
-    using type = Head;
+// whether a tuple of Types can be built element by element from Args
+template <bool SameSize, typename Tuple, typename... Args>
+struct is_tuple_constructible : std::false_type {};
+
+template <std::size_t I, typename Type>
+struct indexed_type {
+    using type = Type;
+};
+
+template <typename Sequence, typename... Types>
+struct indexed_types;
+
+template <std::size_t... Indices, typename... Types>
+struct indexed_types<index_sequence<Indices...>, Types...> : indexed_type<Indices, Types>... {};
+
+// overload resolution picks out the one base with index I, so there's no recursion over Types
+template <std::size_t I, typename Type>
+indexed_type<I, Type> select_indexed(const indexed_type<I, Type>&);
+
+template <std::size_t I, typename... Types>
+struct overload_type_at_index
+    : decltype(select_indexed<I>(
+          indexed_types<typename make_index_sequence<sizeof...(Types)>::type, Types...>())) {};
+
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define LEARN_STL_TYPE_PACK_ELEMENT 1
+#endif
+#endif
+
+#if defined(LEARN_STL_TYPE_PACK_ELEMENT)
+template <size_t I, typename... Types>
+struct type_at_index {
+    using type = __type_pack_element<I, Types...>;
 };
+#else
+template <size_t I, typename... Types>
+struct type_at_index : overload_type_at_index<I, Types...> {};
+#endif
 
 template <size_t I, typename... Types>
 using type_at_index_t = typename type_at_index<I, Types...>::type;
@@ -67,14 +179,98 @@ class tuple_size;
 template <typename... Types>
 class tuple_size<tuple<Types...>> : public std::integral_constant<std::size_t, sizeof...(Types)> {};
 
+namespace detail {
+// folds rather than std::conjunction, which nests one level per element and runs past the
+// instantiation depth limit for large tuples
+template <typename... Types, typename... Args>
+struct is_tuple_constructible<true, ::learn::tuple<Types...>, Args...>
+    : std::bool_constant<(std::is_constructible<Types, Args&&>::value && ...)> {};
+
+// whether Args is a single tuple of type Tuple, which the copy and move constructors take; the
+// forwarding constructor would otherwise win for a non-const lvalue, and an element constructible
+// from the tuple, like any, would copy the tuple through it again
+template <typename Tuple, typename... Args>
+struct is_same_tuple : std::false_type {};
+
+template <typename Tuple, typename Arg>
+struct is_same_tuple<Tuple, Arg> : std::is_same<std::decay_t<Arg>, Tuple> {};
+
+// whether each element of a tuple of Types can be assigned from the matching one of Args
+template <bool SameSize, typename Tuple, typename... Args>
+struct is_tuple_assignable : std::false_type {};
+
+template <typename... Types, typename... Args>
+struct is_tuple_assignable<true, ::learn::tuple<Types...>, Args...>
+    : std::bool_constant<(std::is_assignable<Types&, Args&&>::value && ...)> {};
+}  // namespace detail
+
+// the special members are defaulted, so a tuple of trivially copyable types is itself trivially
+// copyable and learn::vector relocates it with memmove
 template <typename... Types>
-class tuple : public detail::tuple<typename make_index_sequence<sizeof...(Types)>::type, Types...> {
+class tuple {
+    template <typename... Args>
+    static constexpr bool constructible_from =
+        detail::is_tuple_constructible<sizeof...(Args) == sizeof...(Types), tuple, Args...>::value;
+
+    // the tuple itself is rejected before its elements are checked, so checking them doesn't
+    // come back to this constructor
+    template <typename... Args>
+    static constexpr bool forwarding_from =
+        std::conjunction<std::negation<detail::is_same_tuple<tuple, Args...>>,
+                         detail::is_tuple_constructible<sizeof...(Args) == sizeof...(Types),
+                                                        tuple, Args...>>::value;
+
+    template <typename... Args>
+    static constexpr bool assignable_from =
+        detail::is_tuple_assignable<sizeof...(Args) == sizeof...(Types), tuple, Args...>::value;
+
   public:
-    explicit constexpr tuple(const Types&... elements) : TupleImpl(elements...) {}
-    explicit constexpr tuple(Types&&... elements) : TupleImpl(forward<Types>(elements)...) {}
+    // value-initialises every element; a tuple holding references can't be default constructed
+    constexpr tuple() = default;
+    explicit constexpr tuple(const Types&... elements) : impl_(elements...) {}
+    template <typename... Args, typename = std::enable_if_t<forwarding_from<Args...>>>
+    explicit constexpr tuple(Args&&... elements)
+        : impl_(in_place, ::learn::forward<Args>(elements)...) {}
+
+    // converts element by element, e.g. the tuple of references a zip iterator dereferences to
+    // into a tuple of values
+    template <typename... Others,
+              typename = std::enable_if_t<constructible_from<const Others&...>>>
+    constexpr tuple(const tuple<Others...>& other) : impl_(detail::tuple_access::impl(other)) {}
+    template <typename... Others, typename = std::enable_if_t<constructible_from<Others...>>>
+    constexpr tuple(tuple<Others...>&& other)
+        : impl_(::learn::move(detail::tuple_access::impl(other))) {}
+
+    tuple(const tuple&) = default;
+    tuple(tuple&&) = default;
+    tuple& operator=(const tuple&) = default;
+    tuple& operator=(tuple&&) = default;
+    ~tuple() = default;
+
+    template <typename... Others, typename = std::enable_if_t<assignable_from<const Others&...>>>
+    constexpr tuple& operator=(const tuple<Others...>& other) {
+        impl_.assign(detail::tuple_access::impl(other));
+        return *this;
+    }
+
+    template <typename... Others, typename = std::enable_if_t<assignable_from<Others...>>>
+    constexpr tuple& operator=(tuple<Others...>&& other) {
+        impl_.assign(::learn::move(detail::tuple_access::impl(other)));
+        return *this;
+    }
 
   private:
+    friend struct detail::tuple_access;
+
     using TupleImpl = detail::tuple<typename make_index_sequence<sizeof...(Types)>::type, Types...>;
+
+    TupleImpl impl_;
+};
+
+template <>
+class tuple<> {
+  public:
+    constexpr tuple() noexcept = default;
 };
 
 template <std::size_t Index, typename... Types>
@@ -83,8 +279,8 @@ constexpr auto& get(tuple<Types...>& data) noexcept {
     using Type = tuple_element_t<Index, Tuple>;
     using Element = detail::tuple_leaf<Index, Type>;
 
-    Element& base = data;
-    return base.value_;
+    Element& base = detail::tuple_access::impl(data);
+    return base.get();
 };
 
 template <std::size_t Index, typename... Types>
@@ -93,8 +289,306 @@ constexpr const auto& get(const tuple<Types...>& data) noexcept {
     using Type = tuple_element_t<Index, Tuple>;
     using Element = detail::tuple_leaf<Index, Type>;
 
-    const Element& base = data;
-    return base.value_;
+    const Element& base = detail::tuple_access::impl(data);
+    return base.get();
+};
+
+// moves the element out of an rvalue tuple, which structured bindings of a temporary rely on
+template <std::size_t Index, typename... Types>
+constexpr tuple_element_t<Index, tuple<Types...>>&& get(tuple<Types...>&& data) noexcept {
+    using Type = tuple_element_t<Index, tuple<Types...>>;
+    using Element = detail::tuple_leaf<Index, Type>;
+
+    Element& base = detail::tuple_access::impl(data);
+    return static_cast<Type&&>(base.get());
+};
+
+template <std::size_t Index, typename... Types>
+constexpr const tuple_element_t<Index, tuple<Types...>>&& get(
+    const tuple<Types...>&& data) noexcept {
+    using Type = tuple_element_t<Index, tuple<Types...>>;
+    using Element = detail::tuple_leaf<Index, Type>;
+
+    const Element& base = detail::tuple_access::impl(data);
+    return static_cast<const Type&&>(base.get());
+};
+
+namespace detail {
+template <class TupleA, class TupleB, std::size_t... Indices>
+constexpr bool tuple_equal(const TupleA& a, const TupleB& b, index_sequence<Indices...>) {
+    return ((::learn::get<Indices>(a) == ::learn::get<Indices>(b)) && ...);
+}
+
+// the first element that differs decides, and the ones after it are never compared
+template <class TupleA, class TupleB, std::size_t... Indices>
+constexpr bool tuple_less(const TupleA& a, const TupleB& b, index_sequence<Indices...>) {
+    int order = 0;
+    ((order = (order != 0)                                          ? order
+              : (::learn::get<Indices>(a) < ::learn::get<Indices>(b)) ? -1
+              : (::learn::get<Indices>(b) < ::learn::get<Indices>(a)) ? 1
+                                                                      : 0),
+     ...);
+
+    return order < 0;
+}
+}  // namespace detail
+
+template <typename... TypesA, typename... TypesB>
+constexpr bool operator==(const tuple<TypesA...>& a, const tuple<TypesB...>& b) {
+    static_assert(sizeof...(TypesA) == sizeof...(TypesB), "tuples must be the same size");
+    return detail::tuple_equal(a, b, typename make_index_sequence<sizeof...(TypesA)>::type());
+}
+
+template <typename... TypesA, typename... TypesB>
+constexpr bool operator!=(const tuple<TypesA...>& a, const tuple<TypesB...>& b) {
+    return !(a == b);
+}
+
+template <typename... TypesA, typename... TypesB>
+constexpr bool operator<(const tuple<TypesA...>& a, const tuple<TypesB...>& b) {
+    static_assert(sizeof...(TypesA) == sizeof...(TypesB), "tuples must be the same size");
+    return detail::tuple_less(a, b, typename make_index_sequence<sizeof...(TypesA)>::type());
+}
+
+template <typename... TypesA, typename... TypesB>
+constexpr bool operator>(const tuple<TypesA...>& a, const tuple<TypesB...>& b) {
+    return b < a;
+}
+
+template <typename... TypesA, typename... TypesB>
+constexpr bool operator<=(const tuple<TypesA...>& a, const tuple<TypesB...>& b) {
+    return !(b < a);
+}
+
+template <typename... TypesA, typename... TypesB>
+constexpr bool operator>=(const tuple<TypesA...>& a, const tuple<TypesB...>& b) {
+    return !(a < b);
+}
+
+namespace detail {
+template <typename... Types, std::size_t... Indices>
+void swap_referenced(::learn::tuple<Types...>& a, ::learn::tuple<Types...>& b,
+                     index_sequence<Indices...>) {
+    using std::swap;
+    (swap(::learn::get<Indices>(a), ::learn::get<Indices>(b)), ...);
+}
+}  // namespace detail
+
+// swaps the objects two tuples of references refer to; std::iter_swap ends up here when it
+// swaps the temporaries a zip iterator dereferences to
+template <typename... Types,
+          typename = std::enable_if_t<(std::is_lvalue_reference<Types>::value && ...)>>
+void swap(tuple<Types...>&& a, tuple<Types...>&& b) {
+    detail::swap_referenced(a, b, typename make_index_sequence<sizeof...(Types)>::type());
+}
+
+namespace detail {
+template <class Fn, class Tuple, std::size_t... Indices>
+constexpr decltype(auto) apply(Fn&& fn, Tuple&& data, index_sequence<Indices...>) {
+    if constexpr (std::is_member_pointer<std::decay_t<Fn>>::value) {
+        return std::invoke(::learn::forward<Fn>(fn),
+                           ::learn::get<Indices>(::learn::forward<Tuple>(data))...);
+    } else {
+        return ::learn::forward<Fn>(fn)(::learn::get<Indices>(::learn::forward<Tuple>(data))...);
+    }
+}
+}  // namespace detail
+
+// calls fn with the tuple's elements as its arguments, each forwarded with the tuple's value
+// category, so nothing is copied on the way
+template <class Fn, class Tuple>
+constexpr decltype(auto) apply(Fn&& fn, Tuple&& data) {
+    using Sequence = make_index_sequence<tuple_size<std::decay_t<Tuple>>::value>;
+    return detail::apply(::learn::forward<Fn>(fn), ::learn::forward<Tuple>(data),
+                         typename Sequence::type());
+}
+
+namespace detail {
+template <typename... Tuples>
+struct tuple_cat_result;
+
+template <>
+struct tuple_cat_result<> {
+    using type = ::learn::tuple<>;
+};
+
+template <typename... Types>
+struct tuple_cat_result<::learn::tuple<Types...>> {
+    using type = ::learn::tuple<Types...>;
+};
+
+template <typename... Head, typename... Next, typename... Tail>
+struct tuple_cat_result<::learn::tuple<Head...>, ::learn::tuple<Next...>, Tail...>
+    : tuple_cat_result<::learn::tuple<Head..., Next...>, Tail...> {};
+
+template <std::size_t N>
+struct tuple_cat_indices {
+    std::size_t outer[N > 0 ? N : 1];  // the tuple each element of the result comes from
+    std::size_t inner[N > 0 ? N : 1];  // the element's index within that tuple
+};
+
+template <std::size_t... Sizes>
+constexpr tuple_cat_indices<(Sizes + ... + 0)> make_tuple_cat_indices() {
+    constexpr std::size_t sizes[] = {Sizes..., 0};
+
+    tuple_cat_indices<(Sizes + ... + 0)> result{};
+    std::size_t position = 0;
+    for (std::size_t i = 0; i < sizeof...(Sizes); ++i) {
+        for (std::size_t j = 0; j < sizes[i]; ++j, ++position) {
+            result.outer[position] = i;
+            result.inner[position] = j;
+        }
+    }
+
+    return result;
+}
+
+template <class Result, std::size_t... Sizes>
+struct tuple_cat {
+    static constexpr tuple_cat_indices<(Sizes + ... + 0)> indices =
+        make_tuple_cat_indices<Sizes...>();
+
+    template <std::size_t... Positions, class Tuples>
+    static constexpr Result make(index_sequence<Positions...>, Tuples&& tuples) {
+        return Result(::learn::get<indices.inner[Positions]>(
+            ::learn::get<indices.outer[Positions]>(::learn::forward<Tuples>(tuples)))...);
+    }
+};
+}  // namespace detail
+
+// a tuple of every element of every argument in order, each copied or moved from its argument
+// according to the argument's value category
+template <class... Tuples>
+constexpr typename detail::tuple_cat_result<std::decay_t<Tuples>...>::type tuple_cat(
+    Tuples&&... tuples) {
+    using Result = typename detail::tuple_cat_result<std::decay_t<Tuples>...>::type;
+    using Sequence = make_index_sequence<tuple_size<Result>::value>;
+
+    using Concatenate = detail::tuple_cat<Result, tuple_size<std::decay_t<Tuples>>::value...>;
+
+    return Concatenate::make(typename Sequence::type(),
+                             tuple<Tuples&&...>(::learn::forward<Tuples>(tuples)...));
+}
+
+namespace detail {
+template <std::size_t N>
+struct packed_order {
+    std::size_t order[N > 0 ? N : 1];     // the element stored at each position
+    std::size_t position[N > 0 ? N : 1];  // the position each element is stored at
+};
+
+// a stable sort of the elements by descending alignment, which leaves no padding between them
+template <typename... Types>
+constexpr packed_order<sizeof...(Types)> make_packed_order() {
+    constexpr std::size_t n = sizeof...(Types);
+    constexpr std::size_t alignments[n > 0 ? n : 1] = {alignof(Types)...};
+
+    packed_order<n> result{};
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t j = i;
+        for (; j > 0 && alignments[result.order[j - 1]] < alignments[i]; --j) {
+            result.order[j] = result.order[j - 1];
+        }
+        result.order[j] = i;
+    }
+
+    for (std::size_t k = 0; k < n; ++k) {
+        result.position[result.order[k]] = k;
+    }
+
+    return result;
+}
+
+template <std::size_t I, typename Head, typename... Tail>
+constexpr decltype(auto) nth_argument(Head&& head, Tail&&... tail) noexcept {
+    if constexpr (I == 0) {
+        return ::learn::forward<Head>(head);
+    } else {
+        return nth_argument<I - 1>(::learn::forward<Tail>(tail)...);
+    }
+}
+
+template <typename Sequence, typename... Types>
+struct packed_tuple;
+
+// the storage is an ordinary tuple of the reordered types, element k of which is Types[order[k]]
+template <std::size_t... Positions, typename... Types>
+struct packed_tuple<index_sequence<Positions...>, Types...> {
+    static constexpr packed_order<sizeof...(Types)> layout = make_packed_order<Types...>();
+
+    using storage = tuple<index_sequence<Positions...>,
+                          type_at_index_t<layout.order[Positions], Types...>...>;
 };
+}  // namespace detail
+
+// a tuple which stores its elements in descending order of alignment rather than declaration
+// order, so it has as little padding as possible; get<I> still returns the I-th element declared
+template <typename... Types>
+class packed_tuple {
+    using Packed =
+        detail::packed_tuple<typename make_index_sequence<sizeof...(Types)>::type, Types...>;
+    using Storage = typename Packed::storage;
+
+    template <std::size_t... Positions, typename... Args>
+    constexpr packed_tuple(index_sequence<Positions...>, Args&&... elements)
+        : impl_(in_place, detail::nth_argument<Packed::layout.order[Positions]>(
+                              ::learn::forward<Args>(elements)...)...) {}
 
-}  // namespace learn
\ No newline at end of file
+  public:
+    explicit constexpr packed_tuple(const Types&... elements)
+        : packed_tuple(typename make_index_sequence<sizeof...(Types)>::type(), elements...) {}
+    explicit constexpr packed_tuple(Types&&... elements)
+        : packed_tuple(typename make_index_sequence<sizeof...(Types)>::type(),
+                       ::learn::forward<Types>(elements)...) {}
+
+    template <std::size_t Index>
+    static constexpr std::size_t position = Packed::layout.position[Index];
+
+  private:
+    friend struct detail::tuple_access;
+
+    Storage impl_;
+};
+
+template <std::size_t I, typename... Types>
+class tuple_element<I, packed_tuple<Types...>> {
+  public:
+    using type = detail::type_at_index_t<I, Types...>;
+};
+
+template <typename... Types>
+class tuple_size<packed_tuple<Types...>>
+    : public std::integral_constant<std::size_t, sizeof...(Types)> {};
+
+template <std::size_t Index, typename... Types>
+constexpr auto& get(packed_tuple<Types...>& data) noexcept {
+    using Tuple = packed_tuple<Types...>;
+    using Element =
+        detail::tuple_leaf<Tuple::template position<Index>, tuple_element_t<Index, Tuple>>;
+
+    Element& base = detail::tuple_access::impl(data);
+    return base.get();
+};
+
+template <std::size_t Index, typename... Types>
+constexpr const auto& get(const packed_tuple<Types...>& data) noexcept {
+    using Tuple = packed_tuple<Types...>;
+    using Element =
+        detail::tuple_leaf<Tuple::template position<Index>, tuple_element_t<Index, Tuple>>;
+
+    const Element& base = detail::tuple_access::impl(data);
+    return base.get();
+};
+
+}  // namespace learn
+
+// lets a learn::tuple be unpacked with structured bindings
+namespace std {
+template <typename... Types>
+struct tuple_size<::learn::tuple<Types...>> : integral_constant<size_t, sizeof...(Types)> {};
+
+template <size_t I, typename... Types>
+struct tuple_element<I, ::learn::tuple<Types...>> {
+    using type = ::learn::tuple_element_t<I, ::learn::tuple<Types...>>;
+};
+}  // namespace std
\ No newline at end of file
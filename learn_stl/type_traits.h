@@ -3,6 +3,17 @@
 #include <cstdint>
 
 namespace learn {
+namespace detail {
+// how a wrapper such as variant or optional declares one of its special members; trivial ones
+// are left implicit, so the wrapper is trivial whenever what it holds is
+enum class special_member { trivial, provided, deleted };
+
+template <bool Trivial, bool Allowed>
+inline constexpr special_member special_member_v =
+    Trivial ? special_member::trivial
+            : (Allowed ? special_member::provided : special_member::deleted);
+}  // namespace detail
+
 template <std::size_t Len, std::size_t Align>
 struct aligned_storage {
     struct type {
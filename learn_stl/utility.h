@@ -4,29 +4,82 @@
 
 namespace learn {
 
+#if defined(__has_builtin)
+#if __has_builtin(__make_integer_seq)
+#define LEARN_STL_MAKE_INTEGER_SEQ 1
+#elif __has_builtin(__integer_pack)
+#define LEARN_STL_INTEGER_PACK 1
+#endif
+#endif
+
 template <std::size_t... Indices>
-struct index_sequence;
+struct index_sequence {
+    using type = index_sequence<Indices...>;
+};
 
 namespace detail {
-template <std::size_t I, typename Sequence>
-struct cat_index_sequence;
+template <typename Left, typename Right>
+struct join_index_sequence;
+
+template <std::size_t... Left, std::size_t... Right>
+struct join_index_sequence<index_sequence<Left...>, index_sequence<Right...>>
+    : index_sequence<Left..., (sizeof...(Left) + Right)...> {};
+
+// builds 0..N-1 from two halves, so the recursion is log(N) deep rather than N; used when the
+// compiler has no builtin for it
+template <std::size_t N>
+struct split_index_sequence
+    : join_index_sequence<typename split_index_sequence<N / 2>::type,
+                          typename split_index_sequence<N - N / 2>::type>::type {};
 
-template <std::size_t I, size_t... Indices>
-struct cat_index_sequence<I, index_sequence<Indices...> > : index_sequence<Indices..., I> {};
+template <>
+struct split_index_sequence<1> : index_sequence<0> {};
+
+template <>
+struct split_index_sequence<0> : index_sequence<> {};
+
+#if defined(LEARN_STL_MAKE_INTEGER_SEQ)
+template <typename T, T... Indices>
+struct builtin_index_sequence : index_sequence<Indices...> {};
 
+template <std::size_t N>
+using make_index_sequence_t =
+    typename __make_integer_seq<builtin_index_sequence, std::size_t, N>::type;
+#elif defined(LEARN_STL_INTEGER_PACK)
+template <std::size_t N>
+using make_index_sequence_t = index_sequence<__integer_pack(N)...>;
+#else
+template <std::size_t N>
+using make_index_sequence_t = typename split_index_sequence<N>::type;
+#endif
 }  // namespace detail
 
-template <std::size_t... Indices>
-struct index_sequence {
-    using type = index_sequence<Indices...>;
+// the sequence 0..N-1, built by the compiler where it can, which needs no recursion at all
+template <std::size_t N>
+struct make_index_sequence : detail::make_index_sequence_t<N> {};
+
+// tags selecting the constructors that build a value directly in a container's storage
+struct in_place_t {
+    explicit in_place_t() = default;
 };
 
-template <std::size_t N>
-struct make_index_sequence
-    : detail::cat_index_sequence<N - 1, typename make_index_sequence<N - 1>::type>::type {};
+inline constexpr in_place_t in_place{};
 
-template <>
-struct make_index_sequence<1> : index_sequence<0> {};
+template <class Value>
+struct in_place_type_t {
+    explicit in_place_type_t() = default;
+};
+
+template <class Value>
+inline constexpr in_place_type_t<Value> in_place_type{};
+
+template <std::size_t I>
+struct in_place_index_t {
+    explicit in_place_index_t() = default;
+};
+
+template <std::size_t I>
+inline constexpr in_place_index_t<I> in_place_index{};
 
 template <class Value>
 struct remove_reference {
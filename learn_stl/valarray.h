@@ -86,20 +86,27 @@ auto operator%(const Lhs& lhs, const Rhs& rhs) {
     return detail::binary_op<Lhs, Rhs, std::modulus<typename Lhs::value_type>>(lhs, rhs);
 }
 
-template <typename ValueT>
-class valarray : public detail::expression<valarray<ValueT>, ValueT> {
+template <typename ValueT, class AllocatorT = allocator<ValueT>>
+class valarray : public detail::expression<valarray<ValueT, AllocatorT>, ValueT> {
   public:
     using value_type = ValueT;
+    using allocator = AllocatorT;
     using size_type = std::size_t;
     using reference = value_type&;
     using const_reference = const value_type&;
-    using iterator = typename vector<value_type>::iterator;
-    using const_iterator = typename vector<value_type>::const_iterator;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using iterator = typename vector<value_type, allocator>::iterator;
+    using const_iterator = typename vector<value_type, allocator>::const_iterator;
 
     valarray() = default;
     explicit valarray(size_type count) : data_(count) {}
     valarray(const value_type& value, std::size_t count) : data_(count, value) {}
 
+    explicit valarray(const allocator& alloc) : data_(alloc) {}
+    valarray(const value_type& value, std::size_t count, const allocator& alloc)
+        : data_(count, value, alloc) {}
+
     template <typename Expr>
     valarray(const detail::expression<Expr, ValueT>& expression) {
         data_.reserve(expression.size());
@@ -114,6 +121,9 @@ class valarray : public detail::expression<valarray<ValueT>, ValueT> {
     reference operator[](const size_type index) { return data_[index]; }
     const_reference operator[](const size_type index) const { return data_[index]; }
 
+    pointer data() { return data_.data(); }
+    const_pointer data() const { return data_.data(); }
+
     iterator begin() { return data_.begin(); }
     iterator end() { return data_.end(); }
 
@@ -121,13 +131,17 @@ class valarray : public detail::expression<valarray<ValueT>, ValueT> {
     const_iterator end() const { return data_.end(); }
 
   private:
-    using Storage = vector<value_type>;
+    using Storage = vector<value_type, allocator>;
     Storage data_;
 };
 
-template <typename Value>
-bool operator==(const valarray<Value>& lhs, const valarray<Value>& rhs) {
+template <typename Value, class Allocator>
+bool operator==(const valarray<Value, Allocator>& lhs, const valarray<Value, Allocator>& rhs) {
     return std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
+// a valarray whose storage is aligned for full width SIMD loads, see assume_aligned
+template <typename Value, std::size_t Alignment = cache_line_size>
+using aligned_valarray = valarray<Value, aligned_allocator<Value, Alignment>>;
+
 }  // namespace learn
\ No newline at end of file
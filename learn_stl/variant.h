@@ -1,13 +1,19 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 
 #include <algorithm>
+#include <functional>
+#include <limits>
+#include <new>
 #include <type_traits>
 
 #include "algorithm.h"
+#include "memory.h"
 #include "tuple.h"
 #include "type_traits.h"
+#include "utility.h"
 
 namespace learn {
 
@@ -16,6 +22,89 @@ class variant;
 
 inline constexpr std::size_t variant_npos = -1;
 
+template <class Variant>
+struct variant_size;
+
+template <typename... Types>
+struct variant_size<variant<Types...>>
+    : public std::integral_constant<std::size_t, sizeof...(Types)> {};
+
+template <class Variant>
+struct variant_size<const Variant> : public variant_size<Variant> {};
+
+template <class Variant>
+inline constexpr std::size_t variant_size_v = variant_size<Variant>::value;
+
+template <std::size_t I, class Variant>
+struct variant_alternative;
+
+template <std::size_t I, typename... Types>
+struct variant_alternative<I, variant<Types...>> {
+    static_assert(I < sizeof...(Types), "index exceeds number of stored types");
+    using type = detail::type_at_index_t<I, Types...>;
+};
+
+template <std::size_t I, class Variant>
+struct variant_alternative<I, const Variant> {
+    using type = const typename variant_alternative<I, Variant>::type;
+};
+
+template <std::size_t I, class Variant>
+using variant_alternative_t = typename variant_alternative<I, Variant>::type;
+
+// specialise niche_traits for a type with bit patterns that never hold a valid value, so a
+// variant of it and empty alternatives can keep its index in those patterns instead of a
+// separate member; a specialisation provides
+//   count                      - the number of spare patterns
+//   set(void* data, niche)     - writes spare pattern niche, where niche < count, over the object
+//   get(const void* data)      - the spare pattern held, or count or more if data holds a value
+template <class T>
+struct niche_traits {
+    static constexpr std::size_t count = 0;
+};
+
+// for enums with values that are declared invalid, e.g.
+//   template <> struct niche_traits<Color> : enum_niche<Color, Color::invalid> {};
+template <class Enum, Enum... Invalid>
+struct enum_niche {
+    static_assert(std::is_enum<Enum>::value, "enum_niche is for enums");
+
+    static constexpr std::size_t count = sizeof...(Invalid);
+
+    static void set(void* data, std::size_t niche) noexcept {
+        constexpr Enum values[] = {Invalid...};
+        ::new (data) Enum(values[niche]);
+    }
+
+    static std::size_t get(const void* data) noexcept {
+        constexpr Enum values[] = {Invalid...};
+        Enum value;
+        std::memcpy(&value, data, sizeof(Enum));
+
+        return static_cast<std::size_t>(std::find(values, values + count, value) - values);
+    }
+};
+
+// pointers to T are always aligned, so the misaligned addresses 1 to alignof(T) - 1 are spare
+template <class T>
+struct aligned_pointer_niche {
+    static_assert(alignof(T) > 1, "pointers to T have no misaligned values");
+
+    static constexpr std::size_t count = alignof(T) - 1;
+
+    static void set(void* data, std::size_t niche) noexcept {
+        const std::uintptr_t address = niche + 1;
+        std::memcpy(data, &address, sizeof(address));
+    }
+
+    static std::size_t get(const void* data) noexcept {
+        std::uintptr_t address;
+        std::memcpy(&address, data, sizeof(address));
+
+        return address - 1 < count ? address - 1 : count;
+    }
+};
+
 namespace detail {
 template <typename... Types>
 constexpr std::size_t max_sizeof() {
@@ -27,41 +116,32 @@ constexpr std::size_t max_align() {
     return std::max({alignof(Types)...});
 }
 
+// one entry per alternative, indexed directly by the variant's index; a single indirect call
+// however many alternatives there are
 template <typename... Types>
-struct variant_helper;
-
-template <typename T, typename... Types>
-struct variant_helper<T, Types...> {
-    static void destroy(std::size_t id, void* data) {
-        if (id == sizeof...(Types)) {
-            reinterpret_cast<T*>(data)->~T();
-        } else {
-            variant_helper<Types...>::destroy(id, data);
-        }
+struct variant_ops {
+    using destroy_fn = void (*)(void* data) noexcept;
+    using move_fn = void (*)(void* old_v, void* new_v);
+    using copy_fn = void (*)(const void* old_v, void* new_v);
+
+    template <typename T>
+    static void destroy_one(void* data) noexcept {
+        static_cast<T*>(data)->~T();
     }
 
-    static void move(std::size_t old_t, void* old_v, void* new_v) {
-        if (old_t == sizeof...(Types)) {
-            new (new_v) T(std::move(*reinterpret_cast<T*>(old_v)));
-        } else {
-            variant_helper<Types...>::move(old_t, old_v, new_v);
-        }
+    template <typename T>
+    static void move_one(void* old_v, void* new_v) {
+        ::new (new_v) T(::learn::move(*static_cast<T*>(old_v)));
     }
 
-    static void copy(std::size_t old_t, const void* old_v, void* new_v) {
-        if (old_t == sizeof...(Types)) {
-            new (new_v) T(*reinterpret_cast<T*>(old_v));
-        } else {
-            variant_helper<Types...>::move(old_t, old_v, new_v);
-        }
+    template <typename T>
+    static void copy_one(const void* old_v, void* new_v) {
+        ::new (new_v) T(*static_cast<const T*>(old_v));
     }
-};
 
-template <>
-struct variant_helper<> {
-    static void destroy(size_t id, void* data) {}
-    static void move(size_t old_t, void* old_v, void* new_v) {}
-    static void copy(size_t old_t, const void* old_v, void* new_v) {}
+    static constexpr destroy_fn destroy[] = {&destroy_one<Types>...};
+    static constexpr move_fn move[] = {&move_one<Types>...};
+    static constexpr copy_fn copy[] = {&copy_one<Types>...};
 };
 
 template <class Iter, class Value>
@@ -82,11 +162,376 @@ constexpr std::size_t index_of() {
 
     return (iter != values.end()) ? ::std::distance(values.begin(), iter) : variant_npos;
 }
+
+// the smallest unsigned type that can hold every index
+template <std::size_t N>
+using variant_index_t = std::conditional_t<
+    (N <= std::numeric_limits<std::uint8_t>::max()), std::uint8_t,
+    std::conditional_t<(N <= std::numeric_limits<std::uint16_t>::max()), std::uint16_t,
+                       std::uint32_t>>;
+
+template <typename... Types>
+using variant_storage_t =
+    typename aligned_storage<max_sizeof<Types...>(), max_align<Types...>()>::type;
+
+// the index is stored alongside the value
+template <typename... Types>
+struct variant_layout {
+    variant_storage_t<Types...> storage_;
+    variant_index_t<sizeof...(Types)> index_ = 0;
+
+    constexpr std::size_t index() const noexcept { return index_; }
+
+    // called after the alternative has been constructed
+    void set_index(std::size_t index) noexcept {
+        index_ = static_cast<variant_index_t<sizeof...(Types)>>(index);
+    }
+};
+
+template <class T>
+inline constexpr bool is_niche_tag = std::is_empty<T>::value &&
+                                     std::is_trivially_default_constructible<T>::value &&
+                                     std::is_trivially_copyable<T>::value;
+
+// the alternative whose spare patterns can hold the index, or variant_npos; every other
+// alternative has to be an empty tag, as those take up no storage of their own
+template <typename... Types>
+constexpr std::size_t niche_alternative() {
+    constexpr std::size_t others = sizeof...(Types) - 1;
+    constexpr bool is_tag[] = {is_niche_tag<Types>...};
+    constexpr bool has_niches[] = {(niche_traits<Types>::count >= others)...};
+
+    std::size_t niche = variant_npos;
+    for (std::size_t i = 0; i < sizeof...(Types); ++i) {
+        if (!is_tag[i]) {
+            if (niche != variant_npos || !has_niches[i]) {
+                return variant_npos;
+            }
+            niche = i;
+        }
+    }
+
+    return others > 0 ? niche : variant_npos;
+}
+
+// the index lives in a spare pattern of alternative Niche, which tags are stored as
+template <std::size_t Niche, typename... Types>
+struct variant_niche_layout {
+    using traits = niche_traits<type_at_index_t<Niche, Types...>>;
+
+    variant_storage_t<Types...> storage_;
+
+    std::size_t index() const noexcept {
+        const std::size_t niche = traits::get(&storage_);
+
+        if (niche >= sizeof...(Types) - 1) {
+            return Niche;
+        }
+
+        return niche < Niche ? niche : niche + 1;
+    }
+
+    void set_index(std::size_t index) noexcept {
+        if (index != Niche) {
+            traits::set(&storage_, index < Niche ? index : index - 1);
+        }
+    }
+};
+
+template <typename... Types>
+using variant_layout_t =
+    std::conditional_t<niche_alternative<Types...>() == variant_npos, variant_layout<Types...>,
+                       variant_niche_layout<niche_alternative<Types...>(), Types...>>;
+
+// variant's special members are built from a chain of bases, each of which either leaves one
+// member implicit, so it stays trivial when every alternative's is, provides it, or deletes it
+template <typename... Types>
+struct variant_storage_base {
+    using ops = variant_ops<Types...>;
+
+    variant_layout_t<Types...> layout_;
+
+    std::size_t index() const noexcept { return layout_.index(); }
+
+    void destroy() noexcept { ops::destroy[index()](&layout_.storage_); }
+
+    void copy_from(const variant_storage_base& other) {
+        ops::copy[other.index()](&other.layout_.storage_, &layout_.storage_);
+        layout_.set_index(other.index());
+    }
+
+    void move_from(variant_storage_base& other) {
+        ops::move[other.index()](&other.layout_.storage_, &layout_.storage_);
+        layout_.set_index(other.index());
+    }
+
+    // destroys the held value and moves other's in; variant has no empty state, so if the move
+    // throws this falls back to a default constructed first alternative, as emplace does
+    void replace_with(variant_storage_base& other) {
+        if constexpr ((std::is_nothrow_move_constructible<Types>::value && ...)) {
+            destroy();
+            move_from(other);
+        } else {
+            using First = typename type_at_index<0, Types...>::type;
+            static_assert(std::is_nothrow_default_constructible<First>::value,
+                          "assigning types with a throwing move constructor needs a nothrow "
+                          "default constructible first alternative");
+
+            destroy();
+            try {
+                move_from(other);
+            } catch (...) {
+                ::new (static_cast<void*>(&layout_.storage_)) First();
+                layout_.set_index(0);
+                throw;
+            }
+        }
+    }
+};
+
+template <bool Trivial, typename... Types>
+struct variant_destructor : variant_storage_base<Types...> {};
+
+template <typename... Types>
+struct variant_destructor<false, Types...> : variant_storage_base<Types...> {
+    variant_destructor() = default;
+    variant_destructor(const variant_destructor&) = default;
+    variant_destructor(variant_destructor&&) = default;
+    variant_destructor& operator=(const variant_destructor&) = default;
+    variant_destructor& operator=(variant_destructor&&) = default;
+    ~variant_destructor() { this->destroy(); }
+};
+
+template <typename... Types>
+using variant_destructor_t =
+    variant_destructor<(std::is_trivially_destructible<Types>::value && ...), Types...>;
+
+template <special_member Kind, typename... Types>
+struct variant_copy_constructor : variant_destructor_t<Types...> {};
+
+template <typename... Types>
+struct variant_copy_constructor<special_member::provided, Types...>
+    : variant_destructor_t<Types...> {
+    variant_copy_constructor() = default;
+    variant_copy_constructor(const variant_copy_constructor& other) { this->copy_from(other); }
+    variant_copy_constructor(variant_copy_constructor&&) = default;
+    variant_copy_constructor& operator=(const variant_copy_constructor&) = default;
+    variant_copy_constructor& operator=(variant_copy_constructor&&) = default;
+};
+
+template <typename... Types>
+struct variant_copy_constructor<special_member::deleted, Types...>
+    : variant_destructor_t<Types...> {
+    variant_copy_constructor() = default;
+    variant_copy_constructor(const variant_copy_constructor&) = delete;
+    variant_copy_constructor(variant_copy_constructor&&) = default;
+    variant_copy_constructor& operator=(const variant_copy_constructor&) = default;
+    variant_copy_constructor& operator=(variant_copy_constructor&&) = default;
+};
+
+template <typename... Types>
+using variant_copy_constructor_t =
+    variant_copy_constructor<special_member_v<(std::is_trivially_copy_constructible<Types>::value &&
+                                               ...),
+                                              (std::is_copy_constructible<Types>::value && ...)>,
+                             Types...>;
+
+template <special_member Kind, typename... Types>
+struct variant_move_constructor : variant_copy_constructor_t<Types...> {};
+
+template <typename... Types>
+struct variant_move_constructor<special_member::provided, Types...>
+    : variant_copy_constructor_t<Types...> {
+    variant_move_constructor() = default;
+    variant_move_constructor(const variant_move_constructor&) = default;
+    variant_move_constructor(variant_move_constructor&& other) { this->move_from(other); }
+    variant_move_constructor& operator=(const variant_move_constructor&) = default;
+    variant_move_constructor& operator=(variant_move_constructor&&) = default;
+};
+
+template <typename... Types>
+struct variant_move_constructor<special_member::deleted, Types...>
+    : variant_copy_constructor_t<Types...> {
+    variant_move_constructor() = default;
+    variant_move_constructor(const variant_move_constructor&) = default;
+    variant_move_constructor(variant_move_constructor&&) = delete;
+    variant_move_constructor& operator=(const variant_move_constructor&) = default;
+    variant_move_constructor& operator=(variant_move_constructor&&) = default;
+};
+
+template <typename... Types>
+using variant_move_constructor_t =
+    variant_move_constructor<special_member_v<(std::is_trivially_move_constructible<Types>::value &&
+                                               ...),
+                                              (std::is_move_constructible<Types>::value && ...)>,
+                             Types...>;
+
+// assignment destroys the held value and constructs the new one, so it's only trivial when
+// that would be too
+template <special_member Kind, typename... Types>
+struct variant_copy_assign : variant_move_constructor_t<Types...> {};
+
+template <typename... Types>
+struct variant_copy_assign<special_member::provided, Types...>
+    : variant_move_constructor_t<Types...> {
+    variant_copy_assign() = default;
+    variant_copy_assign(const variant_copy_assign&) = default;
+    variant_copy_assign(variant_copy_assign&&) = default;
+    variant_copy_assign& operator=(variant_copy_assign&&) = default;
+
+    // a copy is made first, so a throwing copy constructor leaves this unchanged
+    variant_copy_assign& operator=(const variant_copy_assign& other) {
+        if (this != &other) {
+            variant_copy_assign copy(other);
+            this->replace_with(copy);
+        }
+
+        return *this;
+    }
+};
+
+template <typename... Types>
+struct variant_copy_assign<special_member::deleted, Types...>
+    : variant_move_constructor_t<Types...> {
+    variant_copy_assign() = default;
+    variant_copy_assign(const variant_copy_assign&) = default;
+    variant_copy_assign(variant_copy_assign&&) = default;
+    variant_copy_assign& operator=(const variant_copy_assign&) = delete;
+    variant_copy_assign& operator=(variant_copy_assign&&) = default;
+};
+
+template <class T>
+inline constexpr bool is_trivially_copy_assignable_alternative =
+    std::is_trivially_copy_constructible<T>::value && std::is_trivially_copy_assignable<T>::value &&
+    std::is_trivially_destructible<T>::value;
+
+template <typename... Types>
+using variant_copy_assign_t =
+    variant_copy_assign<special_member_v<(is_trivially_copy_assignable_alternative<Types> && ...),
+                                         (std::is_copy_constructible<Types>::value && ...)>,
+                        Types...>;
+
+template <special_member Kind, typename... Types>
+struct variant_move_assign : variant_copy_assign_t<Types...> {};
+
+template <typename... Types>
+struct variant_move_assign<special_member::provided, Types...> : variant_copy_assign_t<Types...> {
+    variant_move_assign() = default;
+    variant_move_assign(const variant_move_assign&) = default;
+    variant_move_assign(variant_move_assign&&) = default;
+    variant_move_assign& operator=(const variant_move_assign&) = default;
+
+    variant_move_assign& operator=(variant_move_assign&& other) {
+        if (this != &other) {
+            this->replace_with(other);
+        }
+
+        return *this;
+    }
+};
+
+template <typename... Types>
+struct variant_move_assign<special_member::deleted, Types...> : variant_copy_assign_t<Types...> {
+    variant_move_assign() = default;
+    variant_move_assign(const variant_move_assign&) = default;
+    variant_move_assign(variant_move_assign&&) = default;
+    variant_move_assign& operator=(const variant_move_assign&) = default;
+    variant_move_assign& operator=(variant_move_assign&&) = delete;
+};
+
+template <class T>
+inline constexpr bool is_trivially_move_assignable_alternative =
+    std::is_trivially_move_constructible<T>::value && std::is_trivially_move_assignable<T>::value &&
+    std::is_trivially_destructible<T>::value;
+
+template <typename... Types>
+using variant_base_t =
+    variant_move_assign<special_member_v<(is_trivially_move_assignable_alternative<Types> && ...),
+                                         (std::is_move_constructible<Types>::value && ...)>,
+                        Types...>;
+
+template <class Value>
+using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<Value>>;
+
+template <std::size_t... I, class Fn>
+void apply_indices(index_sequence<I...>, Fn& fn) {
+    fn(std::integral_constant<std::size_t, I>{}...);
+}
+
+// calls fn with an integral_constant for every index below N
+template <std::size_t N, class Fn>
+void apply_indices(Fn& fn) {
+    apply_indices(typename make_index_sequence<N>::type{}, fn);
+}
+
+// the Ith alternative with the variant's constness and value category, without checking index()
+template <std::size_t I, class Variant>
+constexpr decltype(auto) get_unchecked(Variant&& value) noexcept {
+    using Value = std::remove_reference_t<Variant>;
+    using T = variant_alternative_t<I, Value>;
+
+    auto* ptr = reinterpret_cast<T*>(&value.store());
+
+    if constexpr (std::is_lvalue_reference<Variant>::value) {
+        return *ptr;
+    } else {
+        return ::learn::move(*ptr);
+    }
+}
+
+// a table with an entry for every combination of alternatives, flattened in row-major order;
+// visiting computes the flat index from the variants' indices and makes one indirect call
+template <class Sequence, class Visitor, class... Variants>
+struct visit_table;
+
+template <std::size_t... Flat, class Visitor, class... Variants>
+struct visit_table<index_sequence<Flat...>, Visitor, Variants...> {
+    using result_type = decltype(std::invoke(std::declval<Visitor>(),
+                                             get_unchecked<0>(std::declval<Variants>())...));
+    using dispatch_fn = result_type (*)(Visitor&& visitor, Variants&&... variants);
+
+    // the trailing zero keeps the array non-empty when there are no variants
+    static constexpr std::size_t sizes[] = {variant_size_v<remove_cvref_t<Variants>>..., 0};
+
+    static constexpr std::size_t index_in(std::size_t flat, std::size_t k) {
+        for (std::size_t i = sizeof...(Variants); i-- > k + 1;) {
+            flat /= sizes[i];
+        }
+
+        return flat % sizes[k];
+    }
+
+    template <std::size_t Index, std::size_t... K>
+    static result_type dispatch(index_sequence<K...>, Visitor&& visitor,
+                                Variants&&... variants) {
+        return std::invoke(
+            ::learn::forward<Visitor>(visitor),
+            get_unchecked<index_in(Index, K)>(::learn::forward<Variants>(variants))...);
+    }
+
+    template <std::size_t Index>
+    static result_type dispatch(Visitor&& visitor, Variants&&... variants) {
+        using Sequence = typename make_index_sequence<sizeof...(Variants)>::type;
+        return dispatch<Index>(Sequence{}, ::learn::forward<Visitor>(visitor),
+                               ::learn::forward<Variants>(variants)...);
+    }
+
+    static constexpr dispatch_fn table[] = {&dispatch<Flat>...};
+};
+
+template <class Visitor, class... Variants>
+using visit_table_for =
+    visit_table<typename make_index_sequence<(variant_size_v<remove_cvref_t<Variants>> * ... *
+                                              std::size_t{1})>::type,
+                Visitor, Variants...>;
 }  // namespace detail
 
 template <class T, class... Types>
 constexpr bool holds_alternative(const variant<Types...>& v) noexcept {
-    return std::disjunction<std::is_same<T, Types>...>::value;
+    constexpr auto index = detail::index_of<T, Types...>();
+    static_assert(index != variant_npos, "type T not in variant");
+
+    return v.index() == index;
 }
 
 struct monostate {};
@@ -94,96 +539,142 @@ struct monostate {};
 class bad_variant_access : public std::exception {};
 
 template <typename... Types>
-class variant {
+class variant : private detail::variant_base_t<Types...> {
+    template <class T>
+    static constexpr bool is_alternative =
+        detail::index_of<std::decay_t<T>, Types...>() != variant_npos;
+
   public:
     static_assert(0 < sizeof...(Types), "variant must consist of at least one alternative");
-    using storage = aligned_storage<detail::max_sizeof<Types...>(), detail::max_align<Types...>()>;
+    using storage = detail::variant_storage_t<Types...>;
 
-    constexpr variant();
+    variant();
 
-    template <class T>
-    constexpr variant(T&& t);
+    template <class T, typename = std::enable_if_t<is_alternative<T>>>
+    variant(T&& t);
 
-    template <class T>
+    template <std::size_t I, class... Args>
+    explicit variant(in_place_index_t<I>, Args&&... args);
+
+    template <class T, class... Args>
+    explicit variant(in_place_type_t<T>, Args&&... args)
+        : variant(in_place_index<detail::index_of<T, Types...>()>,
+                  ::learn::forward<Args>(args)...) {}
+
+    template <class T, typename = std::enable_if_t<is_alternative<T>>>
     variant& operator=(T&& t);
 
-    ~variant();
+    template <std::size_t I, class... Args>
+    variant_alternative_t<I, variant>& emplace(Args&&... args);
 
-    constexpr std::size_t index() const noexcept { return type_id_; }
+    template <class T, class... Args>
+    T& emplace(Args&&... args) {
+        return emplace<detail::index_of<T, Types...>()>(::learn::forward<Args>(args)...);
+    }
 
-    storage& store() { return storage_; }
+    constexpr std::size_t index() const noexcept { return this->layout_.index(); }
 
-    const storage& store() const { return storage_; }
+    storage& store() { return this->layout_.storage_; }
 
-  private:
-    using size_type = std::size_t;
+    const storage& store() const { return this->layout_.storage_; }
 
-    size_type type_id_ = 0;
-    storage storage_;
+  private:
+    // this must not hold a value
+    template <std::size_t I, class... Args>
+    void construct(Args&&... args) {
+        static_assert(I < sizeof...(Types), "index exceeds number of stored types");
+        using T = variant_alternative_t<I, variant>;
+
+        ::new (static_cast<void*>(&store())) T(::learn::forward<Args>(args)...);
+        this->layout_.set_index(I);
+    }
 };
 
 template <typename... Types>
-constexpr variant<Types...>::variant() {
+variant<Types...>::variant() {
     using T = typename detail::type_at_index<0, Types...>::type;
     static_assert(std::is_default_constructible_v<T>, "default type is not default constructable!");
 
-    T t;
-    detail::variant_helper<Types...>::move(0, &t, &storage_);
+    construct<0>();
 }
 
 template <typename... Types>
-template <class T>
-constexpr variant<Types...>::variant(T&& t) {
-    static_assert(holds_alternative<T, Types...>, "varient does not contain type T");
-
-    type_id_ = detail::index_of<T, Types...>();
+template <class T, typename>
+variant<Types...>::variant(T&& t) {
+    construct<detail::index_of<std::decay_t<T>, Types...>()>(::learn::forward<T>(t));
+}
 
-    const auto index = sizeof...(Types) - 1 - type_id_;
-    detail::variant_helper<Types...>::move(index, &t, &storage_);
+template <typename... Types>
+template <std::size_t I, class... Args>
+variant<Types...>::variant(in_place_index_t<I>, Args&&... args) {
+    construct<I>(::learn::forward<Args>(args)...);
 }
 
 template <typename... Types>
-template <class T>
+template <class T, typename>
 variant<Types...>& variant<Types...>::operator=(T&& t) {
-    static_assert(holds_alternative<T, Types...>, "varient does not contain type T");
+    constexpr auto index = detail::index_of<std::decay_t<T>, Types...>();
 
-    auto index = sizeof...(Types) - 1 - type_id_;
-    detail::variant_helper<Types...>::destroy(index, &storage_);
-
-    type_id_ = detail::index_of<T, Types...>();
-
-    index = sizeof...(Types) - 1 - type_id_;
-    detail::variant_helper<Types...>::move(index, &t, &storage_);
+    if (this->index() == index) {
+        detail::get_unchecked<index>(*this) = ::learn::forward<T>(t);
+    } else {
+        emplace<index>(::learn::forward<T>(t));
+    }
 
     return *this;
 }
 
+// variant has no empty state, so the held value is only destroyed once nothing can throw
 template <typename... Types>
-variant<Types...>::~variant() {
-    detail::variant_helper<Types...>::destroy(type_id_, &storage_);
-}
+template <std::size_t I, class... Args>
+variant_alternative_t<I, variant<Types...>>& variant<Types...>::emplace(Args&&... args) {
+    using T = variant_alternative_t<I, variant>;
+
+    if constexpr (std::is_nothrow_constructible<T, Args...>::value) {
+        this->destroy();
+        construct<I>(::learn::forward<Args>(args)...);
+    } else if constexpr (std::is_nothrow_move_constructible<T>::value) {
+        T value(::learn::forward<Args>(args)...);
+        this->destroy();
+        construct<I>(::learn::move(value));
+    } else {
+        // T can't be built aside and moved in, so if building it throws the variant falls back
+        // to a default constructed first alternative
+        using First = variant_alternative_t<0, variant>;
+        static_assert(std::is_nothrow_default_constructible<First>::value,
+                      "emplacing a type with throwing constructors and no nothrow move needs a "
+                      "nothrow default constructible first alternative");
+
+        this->destroy();
+        try {
+            construct<I>(::learn::forward<Args>(args)...);
+        } catch (...) {
+            construct<0>();
+            throw;
+        }
+    }
 
+    return detail::get_unchecked<I>(*this);
+}
 
 template <std::size_t I, typename... OtherTypes>
 const auto& get(const variant<OtherTypes...>& value) {
     static_assert(I < sizeof...(OtherTypes), "index exceeds number of stored types");
-    using T = typename detail::type_at_index<I, OtherTypes...>::type;
     if (I != value.index()) {
         throw bad_variant_access{};
     }
 
-    return *reinterpret_cast<const T*>(&value.store());
+    return detail::get_unchecked<I>(value);
 }
 
 template <std::size_t I, typename... OtherTypes>
 auto& get(variant<OtherTypes...>& value) {
     static_assert(I < sizeof...(OtherTypes), "index exceeds number of stored types");
-    using T = typename detail::type_at_index<I, OtherTypes...>::type;
     if (I != value.index()) {
         throw bad_variant_access{};
     }
 
-    return *reinterpret_cast<T*>(&value.store());
+    return detail::get_unchecked<I>(value);
 }
 
 template <class T, typename... OtherTypes>
@@ -210,6 +701,123 @@ auto& get(variant<OtherTypes...>& value) {
     return get<index>(value);
 }
 
+// calls visitor with the alternatives held by every variant; the variants' indices select one
+// entry of a table of every combination, so this costs the same however many alternatives
+// there are
+template <class Visitor, class... Variants>
+decltype(auto) visit(Visitor&& visitor, Variants&&... variants) {
+    using Table = detail::visit_table_for<Visitor&&, Variants&&...>;
+
+    std::size_t flat = 0;
+    ((flat = flat * variant_size_v<detail::remove_cvref_t<Variants>> + variants.index()), ...);
 
+    return Table::table[flat](::learn::forward<Visitor>(visitor),
+                              ::learn::forward<Variants>(variants)...);
+}
+
+namespace detail {
+template <class Range>
+using range_element_t = remove_cvref_t<decltype(*std::begin(std::declval<Range&>()))>;
+
+// counts the elements holding each alternative, bin_starts[i] is where alternative i's elements
+// start once they're grouped and bin_starts[N] is the number of elements
+template <std::size_t N, class Iterator>
+void count_alternatives(Iterator first, std::size_t count, std::size_t (&bin_starts)[N + 1]) {
+    for (std::size_t i = 0; i < count; ++i) {
+        bin_starts[first[i].index() + 1] += 1;
+    }
+
+    for (std::size_t i = 1; i <= N; ++i) {
+        bin_starts[i] += bin_starts[i - 1];
+    }
+}
+
+template <std::size_t I, class Iterator, class Visitor>
+void visit_bin(Iterator first, const std::size_t* order, const std::size_t* order_end,
+               Visitor& visitor) {
+    for (; order != order_end; ++order) {
+        std::invoke(visitor, get_unchecked<I>(first[*order]));
+    }
+}
+
+template <std::size_t I, class Iterator, class Visitor>
+void visit_run(Iterator first, Iterator last, Visitor& visitor) {
+    for (; first != last; ++first) {
+        std::invoke(visitor, get_unchecked<I>(*first));
+    }
+}
+}  // namespace detail
+
+// visits every variant in range, one alternative at a time; the elements are first binned by
+// index with a counting sort, then each alternative gets its own loop with a direct call to the
+// visitor, rather than an unpredictable indirect call per element. Elements holding the same
+// alternative are visited in their original order
+template <class Range, class Visitor>
+void visit_batched(Range&& range, Visitor&& visitor) {
+    using Variant = detail::range_element_t<Range>;
+    constexpr std::size_t N = variant_size_v<Variant>;
+
+    const auto first = std::begin(range);
+    const auto count = static_cast<std::size_t>(std::distance(first, std::end(range)));
+    if (count == 0) {
+        return;
+    }
+
+    std::size_t bin_starts[N + 1] = {};
+    detail::count_alternatives<N>(first, count, bin_starts);
+
+    // one allocation for the whole range, the positions of each alternative's elements in order
+    std::size_t next[N];
+    std::copy(bin_starts, bin_starts + N, next);
+
+    const auto order = make_unique_for_overwrite<std::size_t[]>(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        order[next[first[i].index()]++] = i;
+    }
+
+    const std::size_t* positions = order.get();
+    const auto visit_all = [&](auto... I) {
+        (detail::visit_bin<I>(first, positions + bin_starts[I], positions + bin_starts[I + 1],
+                              visitor),
+         ...);
+    };
+    detail::apply_indices<N>(visit_all);
+}
+
+// like visit_batched, but groups the elements by swapping them within range, so it needs no
+// extra memory and each alternative's loop walks contiguous elements; the order of range is
+// changed, and elements holding the same alternative aren't visited in any particular order
+template <class Range, class Visitor>
+void visit_batched_unstable(Range&& range, Visitor&& visitor) {
+    using Variant = detail::range_element_t<Range>;
+    constexpr std::size_t N = variant_size_v<Variant>;
+
+    const auto first = std::begin(range);
+    const auto count = static_cast<std::size_t>(std::distance(first, std::end(range)));
+
+    std::size_t bin_starts[N + 1] = {};
+    detail::count_alternatives<N>(first, count, bin_starts);
+
+    // an in-place counting sort, each swap puts at least one element into its final bin
+    std::size_t next[N];
+    std::copy(bin_starts, bin_starts + N, next);
+
+    for (std::size_t bin = 0; bin < N; ++bin) {
+        while (next[bin] < bin_starts[bin + 1]) {
+            const std::size_t index = first[next[bin]].index();
+
+            if (index == bin) {
+                next[bin] += 1;
+            } else {
+                ::learn::swap(first[next[bin]], first[next[index]++]);
+            }
+        }
+    }
+
+    const auto visit_all = [&](auto... I) {
+        (detail::visit_run<I>(first + bin_starts[I], first + bin_starts[I + 1], visitor), ...);
+    };
+    detail::apply_indices<N>(visit_all);
+}
 
-}  // namespace learn
\ No newline at end of file
+}  // namespace learn
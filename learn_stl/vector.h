@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
 
 #include "algorithm.h"
 #include "memory.h"
@@ -38,6 +39,31 @@ class vector {
         }
     }
 
+    vector(const vector& other)
+        : allocator_(AllocatorTraits::select_on_container_copy_construction(other.allocator_)) {
+        reserve(other.size());
+
+        for (const auto& value : other) {
+            emplace_back(value);
+        }
+    }
+
+    vector(vector&& other) noexcept
+        : allocator_(::learn::move(other.allocator_)),
+          begin_(other.begin_),
+          size_(other.size_),
+          capacity_(other.capacity_) {
+        other.begin_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    // copy-and-swap, other is either copy or move constructed
+    vector& operator=(vector other) noexcept {
+        swap(other);
+        return *this;
+    }
+
     ~vector() {
         if (begin_) {
             clear();
@@ -99,7 +125,7 @@ class vector {
             reserve(recommend(size_));
         }
 
-        AllocatorTraits::construct(allocator_, begin_ + size_, forward<Args>(args)...);
+        AllocatorTraits::construct(allocator_, begin_ + size_, ::learn::forward<Args>(args)...);
         size_ += 1;
 
         return back();
@@ -111,6 +137,13 @@ class vector {
 
     void clear();
 
+    void swap(vector& other) noexcept {
+        ::learn::swap(allocator_, other.allocator_);
+        ::learn::swap(begin_, other.begin_);
+        ::learn::swap(size_, other.size_);
+        ::learn::swap(capacity_, other.capacity_);
+    }
+
   private:
     using AllocatorTraits = std::allocator_traits<allocator>;
     allocator allocator_;
@@ -138,10 +171,14 @@ void vector<Value, Allocator>::reserve(size_type new_capacity) {
 
     const auto new_begin = AllocatorTraits::allocate(allocator_, new_capacity);
     if (begin_) {
-        if constexpr (std::is_trivially_constructible<Value>::value) {
+        // trivially copyable types can be relocated by copying their bytes
+        if constexpr (std::is_trivially_copyable<Value>::value) {
             std::memmove(new_begin, begin_, size_ * sizeof(value_type));
         } else {
-            move(begin_, begin_ + size_, new_begin);
+            for (size_type i = 0; i < size_; ++i) {
+                AllocatorTraits::construct(allocator_, new_begin + i, ::learn::move(begin_[i]));
+                AllocatorTraits::destroy(allocator_, begin_ + i);
+            }
         }
 
         AllocatorTraits::deallocate(allocator_, begin_, capacity_);
@@ -170,7 +207,7 @@ typename vector<Value, Allocator>::size_type vector<Value, Allocator>::recommend
 template <typename Value, class Allocator>
 void vector<Value, Allocator>::erase(iterator first, iterator last) {
     // rotate so that first->last is at the end of the vector
-    rotate(first, last, end());
+    ::learn::rotate(first, last, end());
     size_ -= std::distance(first, last);
 }
 
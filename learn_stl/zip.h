@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+#include "tuple.h"
+#include "utility.h"
+
+namespace learn {
+namespace detail {
+// the most capable category every one of the iterators supports
+template <typename... Categories>
+using common_iterator_category_t = std::conditional_t<
+    (std::is_base_of<std::random_access_iterator_tag, Categories>::value && ...),
+    std::random_access_iterator_tag,
+    std::conditional_t<
+        (std::is_base_of<std::bidirectional_iterator_tag, Categories>::value && ...),
+        std::bidirectional_iterator_tag,
+        std::conditional_t<(std::is_base_of<std::forward_iterator_tag, Categories>::value && ...),
+                           std::forward_iterator_tag, std::input_iterator_tag>>>;
+}  // namespace detail
+
+// steps through several sequences in lockstep; dereferencing gives a tuple of references to the
+// current element of each, so algorithms read and write the sequences in place. Every iterator
+// moves together, so only the first is compared
+template <typename... Iterators>
+class zip_iterator {
+    static_assert(sizeof...(Iterators) > 0, "zip_iterator needs at least one iterator");
+
+    using Sequence = typename make_index_sequence<sizeof...(Iterators)>::type;
+
+  public:
+    using iterator_category = detail::common_iterator_category_t<
+        typename std::iterator_traits<Iterators>::iterator_category...>;
+    using value_type = tuple<typename std::iterator_traits<Iterators>::value_type...>;
+    using reference = tuple<typename std::iterator_traits<Iterators>::reference...>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+
+    zip_iterator() = default;
+    explicit constexpr zip_iterator(Iterators... iterators) : iterators_(iterators...) {}
+
+    constexpr reference operator*() const { return dereference(Sequence()); }
+    constexpr reference operator[](difference_type n) const { return *(*this + n); }
+
+    constexpr zip_iterator& operator++() {
+        advance(Sequence(), 1);
+        return *this;
+    }
+
+    constexpr zip_iterator operator++(int) {
+        zip_iterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    constexpr zip_iterator& operator--() {
+        advance(Sequence(), -1);
+        return *this;
+    }
+
+    constexpr zip_iterator operator--(int) {
+        zip_iterator old = *this;
+        --*this;
+        return old;
+    }
+
+    constexpr zip_iterator& operator+=(difference_type n) {
+        advance(Sequence(), n);
+        return *this;
+    }
+
+    constexpr zip_iterator& operator-=(difference_type n) { return *this += -n; }
+
+    constexpr zip_iterator operator+(difference_type n) const { return zip_iterator(*this) += n; }
+    constexpr zip_iterator operator-(difference_type n) const { return zip_iterator(*this) -= n; }
+    friend constexpr zip_iterator operator+(difference_type n, const zip_iterator& iter) {
+        return iter + n;
+    }
+
+    constexpr difference_type operator-(const zip_iterator& other) const {
+        return ::learn::get<0>(iterators_) - ::learn::get<0>(other.iterators_);
+    }
+
+    constexpr bool operator==(const zip_iterator& other) const {
+        return ::learn::get<0>(iterators_) == ::learn::get<0>(other.iterators_);
+    }
+    constexpr bool operator!=(const zip_iterator& other) const { return !(*this == other); }
+    constexpr bool operator<(const zip_iterator& other) const {
+        return ::learn::get<0>(iterators_) < ::learn::get<0>(other.iterators_);
+    }
+    constexpr bool operator>(const zip_iterator& other) const { return other < *this; }
+    constexpr bool operator<=(const zip_iterator& other) const { return !(other < *this); }
+    constexpr bool operator>=(const zip_iterator& other) const { return !(*this < other); }
+
+    // the underlying iterators
+    constexpr const tuple<Iterators...>& iterators() const noexcept { return iterators_; }
+
+  private:
+    template <std::size_t... Indices>
+    constexpr reference dereference(index_sequence<Indices...>) const {
+        return reference(*::learn::get<Indices>(iterators_)...);
+    }
+
+    template <std::size_t... Indices>
+    constexpr void advance(index_sequence<Indices...>, difference_type n) {
+        (std::advance(::learn::get<Indices>(iterators_), n), ...);
+    }
+
+    tuple<Iterators...> iterators_;
+};
+
+template <typename... Ranges>
+using zip_iterator_t = zip_iterator<decltype(std::begin(std::declval<Ranges&>()))...>;
+
+// a non-owning view over several ranges side by side, as long as the shortest of them
+template <typename... Ranges>
+class zip_view {
+  public:
+    using iterator = zip_iterator_t<Ranges...>;
+    using size_type = std::size_t;
+
+    explicit constexpr zip_view(Ranges&... ranges)
+        : size_(std::min({static_cast<size_type>(std::size(ranges))...})),
+          begin_(std::begin(ranges)...),
+          end_(std::next(std::begin(ranges), size_)...) {}
+
+    constexpr iterator begin() const { return begin_; }
+    constexpr iterator end() const { return end_; }
+
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr typename iterator::reference operator[](size_type index) const {
+        return begin_[static_cast<typename iterator::difference_type>(index)];
+    }
+
+  private:
+    size_type size_;
+    iterator begin_;
+    iterator end_;
+};
+
+// zip(a, b, c) iterates over a, b and c together, e.g. to sort parallel arrays by one of them
+//   auto view = learn::zip(keys, values);
+//   std::sort(view.begin(), view.end(), [](const auto& x, const auto& y) {
+//       return learn::get<0>(x) < learn::get<0>(y);
+//   });
+template <typename... Ranges>
+constexpr zip_view<Ranges...> zip(Ranges&... ranges) {
+    return zip_view<Ranges...>(ranges...);
+}
+
+}  // namespace learn